@@ -3,47 +3,113 @@
 
 #include <cmath>
 #include <ctime>
+#include <vector>
+#include <string>
 
 namespace localS
 {
 
 
 template <class TemplType>
-class ActiveWindow : public std::deque<TemplType>
+class ActiveWindow
 {
 
 private:
 
 	unsigned int width_;
+	// A ring once `width' items are kept; the storage is reused after `clear', so that a
+	// window in steady state never allocates
+	std::vector<TemplType> 	items;
+	unsigned int 		head;
+	unsigned int 		count;
+
+	TemplType& at (unsigned int i) { return items[ (head + i) % items.size() ]; }
 
 public:
 
+	class iterator
+	{
+		ActiveWindow* 	window;
+		unsigned int 	i;
+
+	public:
+
+		iterator (ActiveWindow* window_, unsigned int i_) : window(window_), i(i_) {}
+
+		TemplType& operator* () { return window->at(i); }
+		TemplType* operator-> () { return &window->at(i); }
+		iterator& operator++ () { i++; return *this; }
+		iterator operator++ (int) { iterator previous = *this; i++; return previous; }
+		bool operator== (const iterator& other) const { return i == other.i && window == other.window; }
+		bool operator!= (const iterator& other) const { return !(*this == other); }
+	};
+
 	// If width == 0 behave like a normal Deque
 	// Otherwise keep the last `width' elements
-	ActiveWindow (unsigned int width__ = 0) : width_(width__) {}
+	ActiveWindow (unsigned int width__ = 0) : width_(width__), head(0), count(0) { items.reserve(width_); }
 
 	unsigned int width () { return width_; }
-	void width (unsigned int width__) { width_ = width__; }
+	void width (unsigned int width__)
+	{
+		// Keep the most recent items, in order
+		std::vector<TemplType> kept;
+		for ( unsigned int i = ( width__ != 0 && count > width__ ) ? count - width__ : 0 ; i < count ; i++ ) kept.push_back( at(i) );
+		items.swap( kept );
+		head = 0;
+		count = items.size();
+		width_ = width__;
+	}
+
+	unsigned int size () { return count; }
+	bool empty () { return count == 0; }
+	void clear () { items.clear(); head = 0; count = 0; }
+
+	iterator begin () { return iterator(this, 0); }
+	iterator end () { return iterator(this, count); }
+
+	// The oldest and the most recent item; The window mustn't be empty
+	TemplType& front () { return at(0); }
+	TemplType& back () { return at(count - 1); }
 
 	void push (TemplType item)
 	{
-		this->push_back(item);
-		if ( width_ != 0 && this->size() > width_ ) this->pop_front();
+		if ( width_ != 0 && count == width_ )
+		{
+			// Full; overwrite the oldest
+			items[head] = item;
+			head = (head + 1) % items.size();
+		}
+		else if ( count < items.size() )
+		{
+			at(count++) = item;
+		}
+		else
+		{
+			items.push_back(item);
+			count++;
+		}
+	}
+
+	void pop_back ()
+	{
+		if ( count == 0 ) return;
+		count--;
+		if ( head == 0 && count + 1 == items.size() ) items.pop_back();
 	}
 
 	unsigned int search (TemplType item)
 	{
 		int occurrences = 0;
-		for (typename std::deque<TemplType>::iterator it = this->begin() ; it != this->end() ; it++)
-			if ( *it == item ) occurrences++;
+		for (unsigned int i = 0 ; i < count ; i++)
+			if ( at(i) == item ) occurrences++;
 
 		return occurrences;
 	}
 
 	bool find (TemplType item)
 	{
-		for (typename std::deque<TemplType>::iterator it = this->begin() ; it != this->end() ; it++)
-			if ( *it == item ) return true;
+		for (unsigned int i = 0 ; i < count ; i++)
+			if ( at(i) == item ) return true;
 
 		return false;
 	}
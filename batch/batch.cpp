@@ -0,0 +1,332 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <chrono>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// INSTANCES //
+// One JSON object per line, either N-Queens or graph coloring; `id' and `seed' are optional
+//   {"id": 1, "queens": 100, "seed": 7}
+//   {"id": 2, "nodes": 5, "colors": 3, "edges": [[0,1],[1,2],[2,3],[3,4],[4,0]], "seed": 7}
+
+struct Instance
+{
+	long 				id;
+	long 				queens;
+	long 				nodes;
+	long 				colors;
+	vector< pair<long, long> > 	edges;
+	unsigned long 			seed;
+	// Instances with the same key share the same model
+	string 				key;
+};
+
+
+// Reads the integer following `"name":'
+bool parseField (const string& line, const char* name, long& value)
+{
+	string 	field = string("\"") + name + "\"";
+	size_t 	position = line.find( field );
+	if ( position == string::npos ) return false;
+	position = line.find( ':', position + field.size() );
+	if ( position == string::npos ) return false;
+
+	value = strtol( line.c_str() + position + 1, NULL, 10 );
+	return true;
+}
+
+
+bool parseInstance (const string& line, long lineNumber, Instance& instance)
+{
+	long value;
+
+	instance.id = parseField( line, "id", value ) ? value : lineNumber;
+	instance.seed = parseField( line, "seed", value ) ? value : 1;
+	instance.edges.clear();
+
+	if ( parseField( line, "queens", instance.queens ) )
+	{
+		ostringstream key;
+		key << "queens:" << instance.queens;
+		instance.key = key.str();
+		return instance.queens > 0;
+	}
+
+	if ( !parseField( line, "nodes", instance.nodes ) || !parseField( line, "colors", instance.colors ) ) return false;
+	instance.queens = 0;
+
+	size_t begin = line.find( "\"edges\"" );
+	if ( begin == string::npos ) return false;
+	begin = line.find( '[', begin );
+	size_t end = line.find( "]]", begin );
+	if ( begin == string::npos ) return false;
+	end = ( end == string::npos ) ? line.find( ']', begin ) : end + 2;
+
+	// Every pair of numbers is an edge
+	const char* 	cursor = line.c_str() + begin;
+	const char* 	last = line.c_str() + end;
+	vector<long> 	numbers;
+	while ( cursor < last )
+	{
+		if ( *cursor >= '0' && *cursor <= '9' )
+		{
+			char* next;
+			numbers.push_back( strtol( cursor, &next, 10 ) );
+			cursor = next;
+		}
+		else cursor++;
+	}
+	for ( size_t i = 0 ; i + 1 < numbers.size() ; i += 2 )
+	{
+		if ( numbers[i] >= instance.nodes || numbers[i + 1] >= instance.nodes ) return false;
+		instance.edges.push_back( make_pair(numbers[i], numbers[i + 1]) );
+	}
+
+	ostringstream key;
+	key << "coloring:" << instance.nodes << ":" << instance.colors << ":" << line.substr( begin, end - begin );
+	instance.key = key.str();
+	return instance.nodes > 0 && instance.colors > 0;
+}
+
+
+// MODELS //
+
+// Everything an instance needs to be solved; built once and reused by every instance with the same key
+struct Model
+{
+	LsProblemManager 			pm;
+	MaxConflictingVariable 			selectVariable;
+	MinConflictingValue 			selectValue;
+	LsProblemManager::HillConfiguration 	conf;
+	NsIntVarArray 				Var, VarPlus, VarMinus;
+	DsaturInitializer 			initializer;
+
+	Model (const Instance& instance) : pm( 2, instance.seed ), selectVariable( pm ), selectValue( pm ),
+			conf( &selectVariable, &selectValue, 1000, 300, 0.1 ), initializer( pm )
+	{
+		// Only needed until labeling, which copies it into the compact model
+		ConstraintGraph graph;
+
+		if ( instance.queens != 0 )
+		{
+			long N = instance.queens;
+			for (long i=0;  i < N;  ++i)
+			{
+				Var.push_back( NsIntVar(pm, 0, N-1) );
+				VarPlus.push_back(  Var[i] + i );
+				VarMinus.push_back( Var[i] - i );
+			}
+			pm.add( NsAllDiff(Var) );
+			pm.add( NsAllDiff(VarPlus) );
+			pm.add( NsAllDiff(VarMinus) );
+		}
+		else
+		{
+			graph.resize( instance.nodes );
+			for (long i=0;  i < instance.nodes;  ++i)
+				Var.push_back( NsIntVar(pm, 0, instance.colors - 1) );
+			for (size_t e=0;  e < instance.edges.size();  ++e)
+			{
+				long i = instance.edges[e].first, j = instance.edges[e].second;
+				if ( i == j ) continue;
+				pm.add( Var[i] != Var[j] );
+				graph[i].push_back(j);
+				graph[j].push_back(i);
+			}
+			pm.useConstraintGraph( graph );
+			pm.useInitializer( &initializer );
+		}
+
+		pm.label(Var, &conf);
+	}
+};
+
+
+// WORKERS //
+
+// Keeps the most recently used models, so that repeated instances skip model construction
+class Worker
+{
+
+private:
+
+	size_t 			capacity;
+	map<string, Model*> 	models;
+	deque<string> 		order;
+	// Reused by every instance
+	StateVector 		values;
+	string 			result;
+	vector<char> 		buffer;
+
+	Model& model (const Instance& instance)
+	{
+		map<string, Model*>::iterator it = models.find( instance.key );
+		if ( it != models.end() )
+		{
+			// Becomes the most recently used
+			order.erase( find( order.begin(), order.end(), instance.key ) );
+			order.push_back( instance.key );
+			return *it->second;
+		}
+
+		// Built before touching the cache, so that a failed construction leaves it consistent
+		Model* fresh = new Model(instance);
+		if ( models.size() == capacity )
+		{
+			delete models[ order.front() ];
+			models.erase( order.front() );
+			order.pop_front();
+		}
+		models[instance.key] = fresh;
+		order.push_back( instance.key );
+		return *fresh;
+	}
+
+public:
+
+	Worker (size_t capacity_) : capacity(capacity_ == 0 ? 1 : capacity_) {}
+	~Worker (void)
+	{
+		for ( map<string, Model*>::iterator it = models.begin() ; it != models.end() ; it++ ) delete it->second;
+	}
+
+	const string& solve (const Instance& instance)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+		Model& m = model( instance );
+		m.pm.random.seed( instance.seed );
+		m.pm.clearSolutions();
+		m.pm.nextSolution();
+		m.pm.captureState( values );
+
+		double elapsed = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+
+		ostringstream out;
+		out << "{\"id\": " << instance.id << ", \"time\": " << elapsed << ", \"steps\": " << m.conf.maxSteps
+			<< ", \"restarts\": " << m.conf.restarts << ", \"solution\": [";
+		result = out.str();
+
+		// The values are formatted straight into a reused buffer; a value and its comma take at most 12 characters
+		buffer.resize( values.size() * 12 + 1 );
+		char* p = &buffer[0];
+		for ( size_t i = 0 ; i < values.size() ; i++ )
+		{
+			if ( i != 0 ) *p++ = ',';
+			p = TextSolutionWriter::format( p, values[i] );
+		}
+		result.append( &buffer[0], p );
+		result += "]}\n";
+
+		return result;
+	}
+};
+
+
+// Escapes a message to be written as a JSON string
+string escapeJson (const string& text)
+{
+	string escaped;
+	for ( size_t i = 0 ; i < text.size() ; i++ )
+	{
+		unsigned char c = text[i];
+		if ( c == '"' || c == '\\' )
+		{
+			escaped += '\\';
+			escaped += c;
+		}
+		else if ( c < 0x20 )
+		{
+			char code[7];
+			sprintf( code, "\\u%04x", c );
+			escaped += code;
+		}
+		else escaped += c;
+	}
+	return escaped;
+}
+
+
+// Shared by the workers
+mutex 		inputLock, outputLock;
+long 		lineNumber = 0, solved = 0, failed = 0;
+
+
+void work (size_t cacheCapacity)
+{
+	Worker 		worker( cacheCapacity );
+	Instance 	instance;
+	string 		line;
+
+	while ( true )
+	{
+		long number;
+		{
+			lock_guard<mutex> guard( inputLock );
+			if ( !getline( cin, line ) ) return;
+			number = ++lineNumber;
+		}
+		if ( line.find_first_not_of( " \t\r" ) == string::npos ) continue;
+
+		string error;
+		if ( !parseInstance( line, number, instance ) )
+		{
+			error = "Invalid instance";
+		}
+		else
+		{
+			try {
+				const string& result = worker.solve( instance );
+				lock_guard<mutex> guard( outputLock );
+				cout << result << flush;
+				solved++;
+				continue;
+			} catch (exception& exc) {
+				error = exc.what();
+			} catch (...) {
+				error = "Unknown exception";
+			}
+		}
+
+		lock_guard<mutex> guard( outputLock );
+		cout << "{\"line\": " << number << ", \"error\": \"" << escapeJson( error ) << "\"}" << endl;
+		failed++;
+	}
+}
+
+
+int main (int argc, char *argv[])
+{
+	if ( argc > 1 && string(argv[1]) == "-h" ) { cerr << "USAGE: workers modelCache < instances.jsonl > results.jsonl" << endl; exit(1); }
+
+	unsigned workers = (argc > 1) ? atoi(argv[1]) : thread::hardware_concurrency();
+	size_t cacheCapacity = (argc > 2) ? atol(argv[2]) : 4;
+	if ( workers == 0 ) workers = 1;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	vector<thread> pool;
+	for ( unsigned w = 0 ; w < workers ; w++ ) pool.push_back( thread(work, cacheCapacity) );
+	for ( unsigned w = 0 ; w < workers ; w++ ) pool[w].join();
+
+	double elapsed = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+	cerr << "Solved `" << solved << "' instances (`" << failed << "' failed) in `" << elapsed << "' sec with `"
+		<< workers << "' workers: `" << ( elapsed > 0 ? solved / elapsed : 0.0 ) << "' instances/sec" << endl;
+}
@@ -0,0 +1,39 @@
+#! /bin/sh
+
+# Instances/sec for a stream of small N-Queens instances, on 1, 2 and 4 workers
+SEED=1
+while  [ $SEED  -le  2000 ]
+do
+	echo "{\"id\": $SEED, \"queens\": `expr 8 + $SEED % 8`, \"seed\": $SEED}"
+
+	SEED=`expr $SEED + 1`
+done > queens.jsonl
+
+for WORKERS in 1 2 4
+do
+	./batch $WORKERS 8 < queens.jsonl > results.jsonl
+done
+
+# Instances/sec on one worker without and with model reuse, for a stream cycling through 4 graphs of 400 nodes;
+# with room for a single model every instance rebuilds its model, with room for 4 every model is built once
+awk 'BEGIN {
+	for (g = 0; g < 4; g++)
+	{
+		srand(g + 1);
+		edges[g] = "[0,1]";
+		for (i = 1; i < 400; i++)
+		{
+			j = (i + 1) % 400;
+			edges[g] = edges[g] ",[" i "," j "]";
+		}
+		for (i = 0; i < 400; i++)
+			edges[g] = edges[g] ",[" int(rand() * 400) "," int(rand() * 400) "]";
+	}
+	for (id = 1; id <= 400; id++)
+		printf "{\"id\": %d, \"nodes\": 400, \"colors\": 8, \"edges\": [%s], \"seed\": %d}\n", id, edges[id % 4], id;
+}' > coloring.jsonl
+
+for CACHE in 1 4
+do
+	./batch 1 $CACHE < coloring.jsonl > results.jsonl
+done
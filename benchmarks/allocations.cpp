@@ -0,0 +1,140 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Every call of the global operator new is counted, except for those made inside naxos,
+// which the local search reaches only through the calls wrapped below
+static unsigned long allocations = 0;
+static unsigned long naxosDepth = 0;
+
+void* operator new (size_t size)
+{
+	if ( naxosDepth == 0 ) allocations++;
+	void* p = malloc( size == 0 ? 1 : size );
+	if ( p == NULL ) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete (void* p) throw()
+{
+	free( p );
+}
+
+#if __cplusplus >= 201402L
+void operator delete (void* p, size_t) throw()
+{
+	free( p );
+}
+#endif
+
+
+// The naxos calls of a step, wrapped at link time (`--wrap' in the Makefile);
+// Their own allocations, e.g. rebuilding the violated constraint lists, are naxos' concern
+struct NaxosCall
+{
+	NaxosCall (void) { naxosDepth++; }
+	~NaxosCall (void) { naxosDepth--; }
+};
+
+#define WRAP_NAXOS(RESULT, SYMBOL, PARAMETERS, ARGUMENTS) \
+	extern "C" RESULT __real_##SYMBOL PARAMETERS; \
+	extern "C" RESULT __wrap_##SYMBOL PARAMETERS { NaxosCall call; return __real_##SYMBOL ARGUMENTS; }
+
+// NsIntVar::lsSet(NsInt), NsIntVar::lsUnset(), NsIntVar::lsViolatedConstraints(),
+// NsProblemManager::lsViolatedConstraints() and NsProblemManager::lsConflictingVars()
+WRAP_NAXOS( void, _ZN5naxos8NsIntVar5lsSetEl, (void* var, long value), (var, value) )
+WRAP_NAXOS( void, _ZN5naxos8NsIntVar7lsUnsetEv, (void* var), (var) )
+WRAP_NAXOS( const void*, _ZN5naxos8NsIntVar21lsViolatedConstraintsEv, (void* var), (var) )
+WRAP_NAXOS( const void*, _ZN5naxos16NsProblemManager21lsViolatedConstraintsEv, (void* pm), (pm) )
+WRAP_NAXOS( const void*, _ZN5naxos16NsProblemManager17lsConflictingVarsEv, (void* pm), (pm) )
+
+
+// Counts the allocations between consecutive selections, i.e. during a whole step,
+// after `warmup' steps have let the buffers reach their steady size
+struct CountingVariable : public VariableHeuristic
+{
+	VariableHeuristic& 	heuristic;
+	unsigned long 		warmup;
+	unsigned long 		steps;
+	unsigned long 		stepAllocations;
+	unsigned long 		previousAllocations;
+
+	CountingVariable (LsProblemManager& pm_, VariableHeuristic& heuristic_, unsigned long warmup_) :
+			VariableHeuristic(pm_), heuristic(heuristic_), warmup(warmup_), steps(0), stepAllocations(0), previousAllocations(0) {}
+
+	VariablePtr select (void)
+	{
+		if ( steps++ > warmup ) stepAllocations += allocations - previousAllocations;
+		VariablePtr selected = heuristic.select();
+		previousAllocations = allocations;
+
+		return selected;
+	}
+};
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N warmup seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 100;
+		unsigned long warmup = (argc > 2) ? atol(argv[2]) : 100;
+		unsigned long seed = (argc > 3) ? atol(argv[3]) : time(NULL);
+
+		LsProblemManager  pm( 2, seed );
+
+		MaxConflictingVariable 	maxConflicting( pm );
+		CountingVariable 	selectVariable( pm, maxConflicting, warmup );
+		MinConflictingValue 	selectValue( pm );
+
+		LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, 1000, 300, 0.1 );
+
+		NsIntVarArray  Var, VarPlus, VarMinus;
+		for (int i=0;  i < N;  ++i)
+		{
+			Var.push_back( NsIntVar(pm, 0, N-1) );
+			VarPlus.push_back(  Var[i] + i );
+			VarMinus.push_back( Var[i] - i );
+		}
+		pm.add( NsAllDiff(Var) );
+		pm.add( NsAllDiff(VarPlus) );
+		pm.add( NsAllDiff(VarMinus) );
+
+		pm.label(Var, &conf);
+		pm.nextSolution();
+
+		unsigned long measured = ( selectVariable.steps > warmup + 1 ) ? selectVariable.steps - warmup - 1 : 0;
+		cout << "N\tSteps\tMeasuredSteps\tAllocations\tAllocationsPerStep" << endl;
+		double perStep = ( measured == 0 ? 0.0 : static_cast<double>(selectVariable.stepAllocations) / measured );
+		cout << N << "\t" << selectVariable.steps << "\t" << measured << "\t" << selectVariable.stepAllocations << "\t" << perStep << endl;
+		// The local search may allocate only when a buffer grows past its largest size so far,
+		// i.e. doubles, which can't happen more than log2(steps) + 1 times
+		unsigned long growths = 1;
+		for ( unsigned long s = measured ; s > 1 ; s /= 2 ) growths++;
+		if ( selectVariable.stepAllocations > growths )
+		{
+			cerr << "FAILED: `" << selectVariable.stepAllocations << "' allocations outside naxos in `" << measured
+				<< "' steps; Buffer growth accounts for at most `" << growths << "'" << endl;
+			return 1;
+		}
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+		return 1;
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+		return 1;
+	}
+}
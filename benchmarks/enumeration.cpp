@@ -0,0 +1,70 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Collects `solutions' distinct N-Queens solutions, from scratch when `moves' is zero,
+// and prints the distinct solutions per second
+void enumerateQueens (int N, int solutions, unsigned long moves, unsigned long minDistance, unsigned long seed)
+{
+	LsProblemManager  pm( 2, seed );
+
+	MaxConflictingVariable 	selectVariable( pm );
+	MinConflictingValue 	selectValue( pm );
+	LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, 1000, 300, 0.1 );
+
+	NsIntVarArray  Var, VarPlus, VarMinus;
+	for (int i=0;  i < N;  ++i)
+	{
+		Var.push_back( NsIntVar(pm, 0, N-1) );
+		VarPlus.push_back(  Var[i] + i );
+		VarMinus.push_back( Var[i] - i );
+	}
+	pm.add( NsAllDiff(Var) );
+	pm.add( NsAllDiff(VarPlus) );
+	pm.add( NsAllDiff(VarMinus) );
+
+	if ( moves != 0 ) pm.enumerate( moves, minDistance );
+	pm.label(Var, &conf);
+
+	Timer timer;
+	timer.start();
+	for (int s = 0 ; s < solutions ; s++) pm.nextSolution();
+	double elapsed = timer.elapsed();
+
+	cout << N << "\t" << moves << "\t" << minDistance << "\t" << solutions << "\t"
+		<< elapsed << "\t" << solutions / elapsed << endl;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N solutions moves minDistance seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 100;
+		int solutions = (argc > 2) ? atoi(argv[2]) : 100;
+		unsigned long moves = (argc > 3) ? atol(argv[3]) : 4;
+		unsigned long minDistance = (argc > 4) ? atol(argv[4]) : 1;
+		unsigned long seed = (argc > 5) ? atol(argv[5]) : time(NULL);
+
+		// From scratch against starting from the previous solution
+		cout << "N\tMoves\tMinDistance\tSolutions\tTime\tSolutions/sec" << endl;
+		enumerateQueens( N, solutions, 0, 1, seed );
+		enumerateQueens( N, solutions, moves, minDistance, seed );
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
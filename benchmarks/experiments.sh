@@ -0,0 +1,57 @@
+#! /bin/sh
+
+# Sampled against full scan variable heuristics; adaptive and fixed sample sizes
+N=50
+while  [ $N  -le  400 ]
+do
+	./sampling $N 5 0 1325772160
+	./sampling $N 5 8 1325772160
+
+	N=`expr $N + 50`
+done
+
+# Heap allocations per step outside naxos, once the buffers have reached their steady size;
+# Fails when the local search allocates more often than its buffers can grow
+for N in 100 200 400
+do
+	./allocations $N 200 1325772160 || exit 1
+done
+
+# Solution output: stream formatting against the buffered text, binary and memory-mapped writers
+./output 1000000 10 1325772160
+
+# Distinct solutions per second, from scratch against perturbing the previous solution
+./enumeration 100 100 4 1 1325772160
+./enumeration 100 100 8 10 1325772160
+
+# Reassigning a variable against swapping the values of two, all partners or a sample
+./swaps 100 5 0 1325772160
+./swaps 200 5 16 1325772160
+
+# Dedicated CNF engines on uniform random 3-SAT, below and near the threshold
+./walksat 1000 4.0 5 10000000 1325772160
+./walksat 5000 4.2 5 10000000 1325772160
+
+# Hill climbing with and without the convergence trace, compared per step over enough runs to resolve 1%
+./trace 30 1000 1325772160
+
+# Random streams of one seed against consecutive seeds; correlation and cost of creating one
+./streams 16 10000 100000 1325772160
+
+# Startup from a saved binary formula against parsing and indexing the DIMACS one;
+# Fails when a saved formula with damaged occurrence lists is taken in
+./startup 100000 4.2 5 1325772160 || exit 1
+
+# Random conflicting variable from the dense conflict set, as annealing keeps it up to date, against walking the list to it
+./selection 10000 8 3 100 200 1325772160
+./selection 100000 8 3 100 50 1325772160
+
+# Rejected moves undone by the journal against reassigning back, with Constraint Weighting
+./rejection 1000 8 3 100 100 1325772160
+./rejection 10000 8 3 100 20 1325772160
+
+# Greedy initialization of N-Queens, asking naxos for the conflicts of every value tried against counting them
+for N in 250 500 1000 2000
+do
+	./greedy $N 32 1325772160
+done
@@ -0,0 +1,87 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Times the greedy initialization of `N'-Queens, either asking naxos for the conflicts of every value tried
+// or counting them from the difference groups, and returns the violated constraints it leaves; Without
+// `post' the constraints are given only as groups, so that setting a value costs naxos nothing
+unsigned long greedyQueens (int N, unsigned long maxTries, bool counting, bool post, unsigned long seed, double& elapsed)
+{
+	LsProblemManager  pm( 2, seed );
+
+	MaxConflictingVariable 	selectVariable( pm );
+	MinConflictingValue 	selectValue( pm );
+	LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, 1000 );
+
+	NsIntVarArray Var, VarPlus, VarMinus;
+	for (int i=0;  i < N;  ++i)
+	{
+		Var.push_back( NsIntVar(pm, 0, N-1) );
+		VarPlus.push_back(  Var[i] + i );
+		VarMinus.push_back( Var[i] - i );
+	}
+	if ( post )
+	{
+		pm.add( NsAllDiff(Var) );
+		pm.add( NsAllDiff(VarPlus) );
+		pm.add( NsAllDiff(VarMinus) );
+	}
+
+	// The same three constraints as groups
+	DifferenceGroups groups( 3 );
+	for (int i=0;  i < N;  ++i)
+	{
+		groups[0].push_back( make_pair(i, 0) );
+		groups[1].push_back( make_pair(i, i) );
+		groups[2].push_back( make_pair(i, -i) );
+	}
+
+	GreedyInitializer 	initializer( pm, GreedyInitializer::RANDOM_ORDER, maxTries );
+	if ( counting ) initializer.useDifferenceGroups( &groups );
+	pm.label(Var, &conf);
+
+	Timer timer;
+	timer.start();
+	initializer.assign( Var );
+	elapsed = timer.elapsed();
+
+	return pm.lsViolatedConstraints().size();
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N maxTries seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 1000;
+		unsigned long maxTries = (argc > 2) ? atol(argv[2]) : 32;
+		unsigned long seed = (argc > 3) ? atol(argv[3]) : time(NULL);
+
+		// Microseconds per variable, and the conflicts left for the search; The counting itself is timed
+		// alone too, as with the constraints posted every `lsSet()' costs naxos the degree of the variable
+		double 		probingTime, countingTime, aloneTime;
+		unsigned long 	probingConflicts = greedyQueens( N, maxTries, false, true, seed, probingTime );
+		unsigned long 	countingConflicts = greedyQueens( N, maxTries, true, true, seed, countingTime );
+		greedyQueens( N, maxTries, true, false, seed, aloneTime );
+		cout << "N\tTries\tProbing\tCounting\tCountingAlone\tSpeedup\tProbingConflicts\tCountingConflicts" << endl;
+		cout << N << "\t" << maxTries << "\t" << 1e6 * probingTime / N << "\t" << 1e6 * countingTime / N << "\t"
+			<< 1e6 * aloneTime / N << "\t"
+			<< ( countingTime > 0.0 ? probingTime / countingTime : 0.0 ) << "\t" << probingConflicts << "\t" << countingConflicts << endl;
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
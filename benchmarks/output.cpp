@@ -0,0 +1,85 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Writes `solutions' copies of `values' to `path' through `writer' and returns the time taken
+double timeWriter (SolutionCallback& writer, const StateVector& values, int solutions)
+{
+	Timer timer;
+	timer.start();
+	for (int s = 0 ; s < solutions ; s++) writer( &values[0], values.size() );
+
+	return timer.elapsed();
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N solutions seed" << endl; exit(1); }
+
+		long N = (argc > 1) ? atol(argv[1]) : 1000000;
+		int solutions = (argc > 2) ? atoi(argv[2]) : 10;
+		unsigned long seed = (argc > 3) ? atol(argv[3]) : time(NULL);
+
+		// A random permutation stands for a solution of N-Queens
+		MTRand_int32 	random( seed );
+		StateVector 	values( N );
+		for (long i = 0 ; i < N ; i++) values[i] = i;
+		for (long i = N ; i > 1 ; i--) swap( values[i - 1], values[ random(i) ] );
+
+		cout << "N\tWriter\tTime\tMB/sec" << endl;
+
+		{
+			// Formatting every value through the stream, as `solutionToString' used to
+			ofstream out( "output.txt" );
+			Timer timer;
+			timer.start();
+			for (int s = 0 ; s < solutions ; s++)
+			{
+				for (long i = 0 ; i < N ; i++) out << (i ? " " : "") << values[i];
+				out << "\n";
+			}
+			out.flush();
+			double elapsed = timer.elapsed();
+			cout << N << "\tostream\t" << elapsed << "\t" << out.tellp() / elapsed / 1e6 << endl;
+		}
+		{
+			ofstream out( "output.txt" );
+			TextSolutionWriter writer( out );
+			double elapsed = timeWriter( writer, values, solutions );
+			out.flush();
+			cout << N << "\tText\t" << elapsed << "\t" << out.tellp() / elapsed / 1e6 << endl;
+		}
+		{
+			ofstream out( "output.bin", ios::binary );
+			BinarySolutionWriter writer( out );
+			double elapsed = timeWriter( writer, values, solutions );
+			out.flush();
+			cout << N << "\tBinary\t" << elapsed << "\t" << out.tellp() / elapsed / 1e6 << endl;
+		}
+#ifdef LOCAL_S_MAPPED_WRITER
+		{
+			MappedSolutionWriter writer( "output.bin" );
+			double elapsed = timeWriter( writer, values, solutions );
+			cout << N << "\tMapped\t" << elapsed << "\t" << 4.0 * N * solutions / elapsed / 1e6 << endl;
+		}
+#endif
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
@@ -0,0 +1,151 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Thrown when the steps of a run are over
+struct Stopped {};
+
+
+// On the state of every step, times `draws' rejected moves of random conflicting variables to random
+// values, undone by reassigning or by the journal, and the same moves made and undone in naxos alone,
+// which both pay; Stops the search after `budget' steps
+struct TimedVariable : public VariableHeuristic
+{
+	RandomVariable 		randomVariable;
+	std::vector<VariablePtr> 	conflicting;
+	unsigned long 		draws;
+	unsigned long 		budget;
+	unsigned long 		steps;
+	double 			reassignTime;
+	double 			journalTime;
+	double 			naxosTime;
+
+	TimedVariable (LsProblemManager& pm_, unsigned long draws_, unsigned long budget_) :
+			VariableHeuristic(pm_), randomVariable(pm_), draws(draws_), budget(budget_),
+			steps(0), reassignTime(0.0), journalTime(0.0), naxosTime(0.0) {}
+
+	Assignment randomMove (void)
+	{
+		VariablePtr 	variable = conflicting[ pm.random( conflicting.size() ) ];
+		NsInt 		value;
+		do value = variable->min() + pm.random( variable->size() ); while ( value == variable->lsValue() );
+
+		return std::make_pair(variable, value);
+	}
+
+	VariablePtr select (void)
+	{
+		if ( steps++ == budget ) throw Stopped();
+
+		// The same moves for both, of the variables conflicting now
+		conflicting = pm.conflictingVariables();
+		unsigned long 	seed = pm.random();
+		Timer timer;
+		timer.start();
+		for (unsigned long d = 0 ; d < draws ; d++)
+		{
+			Assignment 	move = randomMove();
+			NsInt 		currentValue = move.first->lsValue();
+			pm.applyAssignment( move );
+			pm.applyAssignment( std::make_pair(move.first, currentValue) );
+		}
+		reassignTime += timer.elapsed();
+
+		pm.random.seed( seed );
+		timer.start();
+		for (unsigned long d = 0 ; d < draws ; d++)
+		{
+			Assignment 	move = randomMove();
+			pm.markMove();
+			pm.applyAssignment( move );
+			pm.undoMove();
+		}
+		journalTime += timer.elapsed();
+
+		// The naxos variables bypassing the problem manager, whose own bookkeeping is left as it is
+		pm.random.seed( seed );
+		timer.start();
+		for (unsigned long d = 0 ; d < draws ; d++)
+		{
+			Assignment 	move = randomMove();
+			NsInt 		currentValue = move.first->lsValue();
+			move.first->lsUnset();
+			move.first->lsSet( move.second );
+			move.first->lsUnset();
+			move.first->lsSet( currentValue );
+		}
+		naxosTime += timer.elapsed();
+
+		return randomVariable.select();
+	}
+};
+
+
+// Colors a random graph of `nodes' nodes and `degree * nodes / 2' edges with too few colors, with Constraint
+// Weighting, so that undoing a move by reassigning recounts the weights of the constraints of the variable
+void rejectColoring (unsigned long nodes, unsigned long degree, int colors, unsigned long draws, unsigned long steps, unsigned long seed)
+{
+	LsProblemManager  pm( 2, seed );
+
+	TimedVariable 		selectVariable( pm, draws, steps );
+	MinConflictingValue 	selectValue( pm );
+	LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, 5, 2, 0.0, 1 );
+
+	NsIntVarArray  Nodes;
+	for (unsigned long i = 0 ; i < nodes ; i++)
+		Nodes.push_back( NsIntVar(pm, 0, colors - 1) );
+	MTRand_int32 	random( seed );
+	for (unsigned long e = 0 ; e < degree * nodes / 2 ; e++)
+	{
+		unsigned long 	a = random( nodes ), b;
+		do b = random( nodes ); while ( b == a );
+		pm.add( Nodes[a] != Nodes[b] );
+	}
+
+	pm.label(Nodes, &conf);
+	try {
+		pm.nextSolution();
+	} catch (Stopped&) {
+	}
+
+	double 	total = static_cast<double>( steps ) * draws;
+	cout << nodes << "\t" << degree << "\t" << colors << "\t" << 1e9 * selectVariable.reassignTime / total << "\t"
+		<< 1e9 * selectVariable.journalTime / total << "\t" << 1e9 * selectVariable.naxosTime / total << "\t"
+		<< ( selectVariable.journalTime > 0.0 ? selectVariable.reassignTime / selectVariable.journalTime : 0.0 ) << endl;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: nodes degree colors draws steps seed" << endl; exit(1); }
+
+		unsigned long nodes = (argc > 1) ? atol(argv[1]) : 1000;
+		unsigned long degree = (argc > 2) ? atol(argv[2]) : 8;
+		int colors = (argc > 3) ? atoi(argv[3]) : 3;
+		unsigned long draws = (argc > 4) ? atol(argv[4]) : 100;
+		unsigned long steps = (argc > 5) ? atol(argv[5]) : 100;
+		unsigned long seed = (argc > 6) ? atol(argv[6]) : time(NULL);
+		// A rejected move needs another value to move to
+		if ( colors < 2 ) { cerr << "rejection: At least 2 colors are needed" << endl; exit(1); }
+
+		// Nanoseconds per rejected move, on the same states and moves for all
+		cout << "Nodes\tDegree\tColors\tReassign\tJournal\tNaxosOnly\tSpeedup" << endl;
+		rejectColoring( nodes, degree, colors, draws, steps, seed );
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
@@ -0,0 +1,94 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+enum Heuristic {MAX_CONFLICTING, SAMPLED_CONFLICTING, BEST_IMPROVEMENT, SAMPLED_BEST_IMPROVEMENT};
+
+const char* heuristicNames[] = {"MaxConflicting", "SampledConflicting", "BestImprovement", "SampledBestImprovement"};
+
+
+// Solves N-Queens once and returns the time to solution; `steps' receives the steps of the last iteration
+double solveQueens (int N, Heuristic heuristic, unsigned long sampleSize, unsigned long seed, unsigned long& steps)
+{
+	LsProblemManager  pm( 2, seed );
+
+	MaxConflictingVariable 		maxConflicting( pm );
+	SampledConflictingVariable 	sampledConflicting( pm, sampleSize );
+	BestImprovementVariable 	bestImprovement( pm );
+	SampledBestImprovementVariable 	sampledBestImprovement( pm, sampleSize );
+	MinConflictingValue 		minConflictingValue( pm );
+	BestImprovementValue 		bestImprovementValue( pm, bestImprovement );
+	BestImprovementValue 		sampledBestImprovementValue( pm, sampledBestImprovement );
+
+	VariableHeuristic* 	selectVariable = &maxConflicting;
+	ValueHeuristic* 	selectValue = &minConflictingValue;
+	if ( heuristic == SAMPLED_CONFLICTING ) 	selectVariable = &sampledConflicting;
+	if ( heuristic == BEST_IMPROVEMENT ) 		{ selectVariable = &bestImprovement; selectValue = &bestImprovementValue; }
+	if ( heuristic == SAMPLED_BEST_IMPROVEMENT ) 	{ selectVariable = &sampledBestImprovement; selectValue = &sampledBestImprovementValue; }
+
+	LsProblemManager::HillConfiguration conf( selectVariable, selectValue, 1000, 300, 0.1 );
+
+	NsIntVarArray  Var, VarPlus, VarMinus;
+	for (int i=0;  i < N;  ++i)
+	{
+		Var.push_back( NsIntVar(pm, 0, N-1) );
+		VarPlus.push_back(  Var[i] + i );
+		VarMinus.push_back( Var[i] - i );
+	}
+	pm.add( NsAllDiff(Var) );
+	pm.add( NsAllDiff(VarPlus) );
+	pm.add( NsAllDiff(VarMinus) );
+
+	pm.label(Var, &conf);
+
+	Timer timer;
+	timer.start();
+	pm.nextSolution();
+	steps = conf.maxSteps;
+
+	return timer.elapsed();
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N runs sampleSize seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 100;
+		int runs = (argc > 2) ? atoi(argv[2]) : 5;
+		// Zero means adaptive (square root of the conflict set size)
+		unsigned long sampleSize = (argc > 3) ? atol(argv[3]) : 0;
+		unsigned long seed = (argc > 4) ? atol(argv[4]) : time(NULL);
+
+		// Time to solution and steps, averaged over `runs' seeds, for every heuristic
+		cout << "N\tHeuristic\tSampleSize\tAvgTime\tAvgSteps" << endl;
+		for (int h = MAX_CONFLICTING ; h <= SAMPLED_BEST_IMPROVEMENT ; h++)
+		{
+			double 		totalTime = 0.0;
+			unsigned long 	totalSteps = 0, steps;
+			for (int r = 0 ; r < runs ; r++)
+			{
+				totalTime += solveQueens( N, static_cast<Heuristic>(h), sampleSize, seed + r, steps );
+				totalSteps += steps;
+			}
+			cout << N << "\t" << heuristicNames[h] << "\t" << sampleSize << "\t"
+				<< totalTime / runs << "\t" << totalSteps / runs << endl;
+		}
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
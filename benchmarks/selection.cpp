@@ -0,0 +1,130 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Thrown when the steps of a run are over
+struct Stopped {};
+
+
+// Returns a conflicting variable at random by walking the list of naxos to it, as RandomVariable once did
+struct ListRandomVariable : public VariableHeuristic
+{
+	ListRandomVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		unsigned long 		selection = pm.random( conflictSet.size() );
+		ConfVariables::const_iterator 	it = conflictSet.begin();
+		for ( ; selection != 0 ; selection-- ) it++;
+
+		return *it;
+	}
+};
+
+
+// Times `draws' selections of both heuristics on the state of every annealing step, as the temperature of every
+// step is asked for, and stops the search after `budget' steps; The temperature is kept high, so that the
+// conflict set stays large
+struct TimedScheduler : public TemperatureScheduler
+{
+	RandomVariable 		randomVariable;
+	ListRandomVariable 	listRandomVariable;
+	unsigned long 		draws;
+	unsigned long 		budget;
+	unsigned long 		steps;
+	double 			denseTime;
+	double 			listTime;
+	unsigned long 		conflicting;
+
+	TimedScheduler (LsProblemManager& pm_, unsigned long draws_, unsigned long budget_) :
+			TemperatureScheduler(pm_, 1), randomVariable(pm_), listRandomVariable(pm_), draws(draws_), budget(budget_),
+			steps(0), denseTime(0.0), listTime(0.0), conflicting(0) {}
+
+	double operator[] (unsigned long)
+	{
+		if ( steps++ == budget ) throw Stopped();
+
+		// The list of naxos and the dense set are brought up to date first, so that only the draws are timed
+		conflicting += pm.lsConflictingVars().size();
+		pm.conflictingVariables();
+		VariablePtr 	selected = NULL;
+		Timer timer;
+		timer.start();
+		for (unsigned long d = 0 ; d < draws ; d++) selected = listRandomVariable.select();
+		listTime += timer.elapsed();
+
+		timer.start();
+		for (unsigned long d = 0 ; d < draws ; d++) selected = randomVariable.select();
+		denseTime += timer.elapsed();
+
+		return selected != NULL ? 1000.0 : 0.0;
+	}
+};
+
+
+// Anneals a random graph of `nodes' nodes and `degree * nodes / 2' edges with too few colors, so that the
+// conflict set stays large, for `steps' steps; Annealing keeps the dense set up to date on every assignment
+void annealColoring (unsigned long nodes, unsigned long degree, int colors, unsigned long draws, unsigned long steps, unsigned long seed)
+{
+	LsProblemManager  pm( 2, seed );
+
+	TimedScheduler 		scheduler( pm, draws, steps );
+	LsProblemManager::AnnealingConfiguration conf( &scheduler );
+
+	NsIntVarArray  Nodes;
+	for (unsigned long i = 0 ; i < nodes ; i++)
+		Nodes.push_back( NsIntVar(pm, 0, colors - 1) );
+	MTRand_int32 	random( seed );
+	for (unsigned long e = 0 ; e < degree * nodes / 2 ; e++)
+	{
+		unsigned long 	a = random( nodes ), b;
+		do b = random( nodes ); while ( b == a );
+		pm.add( Nodes[a] != Nodes[b] );
+	}
+
+	pm.label(Nodes, &conf);
+	try {
+		pm.nextSolution();
+	} catch (Stopped&) {
+	}
+
+	double 	total = static_cast<double>( steps ) * draws;
+	cout << nodes << "\t" << degree << "\t" << colors << "\t" << scheduler.conflicting / steps << "\t"
+		<< 1e9 * scheduler.listTime / total << "\t" << 1e9 * scheduler.denseTime / total << "\t"
+		<< ( scheduler.denseTime > 0.0 ? scheduler.listTime / scheduler.denseTime : 0.0 ) << endl;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: nodes degree colors draws steps seed" << endl; exit(1); }
+
+		unsigned long nodes = (argc > 1) ? atol(argv[1]) : 10000;
+		unsigned long degree = (argc > 2) ? atol(argv[2]) : 8;
+		int colors = (argc > 3) ? atoi(argv[3]) : 3;
+		unsigned long draws = (argc > 4) ? atol(argv[4]) : 100;
+		unsigned long steps = (argc > 5) ? atol(argv[5]) : 200;
+		unsigned long seed = (argc > 6) ? atol(argv[6]) : time(NULL);
+
+		// Nanoseconds per selection, on the same states for both
+		cout << "Nodes\tDegree\tColors\tAvgConflicting\tListWalk\tDenseSet\tSpeedup" << endl;
+		annealColoring( nodes, degree, colors, draws, steps, seed );
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
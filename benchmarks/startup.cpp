@@ -0,0 +1,141 @@
+#include <naxos.h>
+#include <localS.h>
+#include <walksat.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <iterator>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Writes a uniform random 3-SAT formula of `variables' variables and `ratio * variables' clauses to `path'
+void writeRandom3Sat (const char* path, unsigned int variables, double ratio, unsigned long seed)
+{
+	MTRand_int32 	random( seed );
+	unsigned int 	clauses = static_cast<unsigned int>( ratio * variables + 0.5 );
+
+	ofstream out( path );
+	out << "c uniform random 3-SAT, seed " << seed << "\n";
+	out << "p cnf " << variables << " " << clauses << "\n";
+	for (unsigned int c = 0 ; c < clauses ; c++)
+	{
+		unsigned long 	a = random( variables ), b, d;
+		do b = random( variables ); while ( b == a );
+		do d = random( variables ); while ( d == a || d == b );
+		unsigned long 	chosen[] = {a, b, d};
+		for (int k = 0 ; k < 3 ; k++)
+			out << ( random(2) ? "-" : "" ) << chosen[k] + 1 << " ";
+		out << "0\n";
+	}
+}
+
+
+// Time until the first flip could be made: loading, indexing and the initial assignment
+double timeFormula (const char* path, unsigned long seed, unsigned int& unsatisfied)
+{
+	Timer timer;
+	timer.start();
+
+	SatProblemManager 	sat( seed );
+	sat.load( path );
+	SatProblemManager::WalkSatConfiguration 	conf( 0.567, 0 );
+	sat.solve( &conf );
+
+	unsatisfied = sat.numUnsatisfied();
+	return timer.elapsed();
+}
+
+
+// Copies of the saved formula at `path' with occurrence lists still inside their ranges but not matching the clauses
+// must be refused; Returns how many of them were taken in
+int acceptedDamaged (const char* path, unsigned long seed)
+{
+	ifstream 	in( path, ios::binary );
+	string 		saved( (istreambuf_iterator<char>(in)), istreambuf_iterator<char>() );
+	unsigned int 	v = readWord( &saved[8] ), clauses = readWord( &saved[12] ), literalCount = readWord( &saved[16] );
+	size_t 		occurrenceOffsets = 20 + 4 * ( (clauses + 1) + literalCount );
+	size_t 		occurrences = occurrenceOffsets + 4 * ( 2 * v + 1 );
+
+	// The first entries of the first two non-empty lists swapped, and the first entry made another clause
+	size_t 		lists[2], found = 0;
+	for ( unsigned int l = 0 ; l < 2 * v && found < 2 ; l++ )
+		if ( readWord( &saved[occurrenceOffsets + 4 * l] ) != readWord( &saved[occurrenceOffsets + 4 * (l + 1)] ) )
+			lists[found++] = occurrences + 4 * readWord( &saved[occurrenceOffsets + 4 * l] );
+	naxos::assert_Ns( found == 2 && clauses > 1, "The formula is too small to damage" );
+	string 		swapped( saved ), moved( saved );
+	for ( int b = 0 ; b < 4 ; b++ ) swap( swapped[lists[0] + b], swapped[lists[1] + b] );
+	string 		other;
+	appendWord( other, ( readWord( &saved[lists[0]] ) + 1 ) % clauses );
+	moved.replace( lists[0], 4, other );
+
+	int 		accepted = 0;
+	string 		damaged[] = {swapped, moved};
+	for ( int d = 0 ; d < 2 ; d++ )
+	{
+		ofstream( "damaged.bin", ios::binary ).write( damaged[d].data(), damaged[d].size() );
+		try {
+			SatProblemManager 	sat( seed );
+			sat.load( "damaged.bin" );
+			accepted++;
+		} catch (NsException&) {
+		}
+	}
+
+	return accepted;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: variables ratio runs seed" << endl; exit(1); }
+
+		unsigned int variables = (argc > 1) ? atoi(argv[1]) : 100000;
+		double ratio = (argc > 2) ? atof(argv[2]) : 4.2;
+		int runs = (argc > 3) ? atoi(argv[3]) : 5;
+		unsigned long seed = (argc > 4) ? atol(argv[4]) : time(NULL);
+
+		// The same seeds give the same initial assignments from either file
+		writeRandom3Sat( "random3sat.cnf", variables, ratio, seed );
+		{
+			SatProblemManager 	sat( seed );
+			sat.load( "random3sat.cnf" );
+			sat.save( "random3sat.bin" );
+		}
+		double 		textTime = 0.0, binaryTime = 0.0;
+		for (int r = 0 ; r < runs ; r++)
+		{
+			unsigned int 	textUnsat, binaryUnsat;
+			textTime += timeFormula( "random3sat.cnf", seed + r, textUnsat );
+			binaryTime += timeFormula( "random3sat.bin", seed + r, binaryUnsat );
+			naxos::assert_Ns( textUnsat == binaryUnsat, "The saved formula doesn't match the DIMACS one" );
+		}
+
+		int accepted = acceptedDamaged( "random3sat.bin", seed );
+		if ( accepted != 0 )
+		{
+			cerr << "FAILED: `" << accepted << "' damaged formula files taken in" << endl;
+			return 1;
+		}
+
+		cout << "Variables\tRuns\tText\tBinary\tSpeedup" << endl;
+		cout << variables << "\t" << runs << "\t" << textTime / runs << "\t" << binaryTime / runs << "\t"
+			<< ( binaryTime > 0.0 ? textTime / binaryTime : 0.0 ) << endl;
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+		return 1;
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+		return 1;
+	}
+}
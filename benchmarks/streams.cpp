@@ -0,0 +1,86 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Largest absolute correlation between the first `draws' numbers of any two of the `generators'
+double maxCorrelation (vector<MTRand_int32*>& generators, int draws)
+{
+	vector< vector<double> > 	series( generators.size(), vector<double>( draws ) );
+	for (size_t g = 0 ; g < generators.size() ; g++)
+	{
+		double mean = 0.0, deviation = 0.0;
+		for (int d = 0 ; d < draws ; d++) mean += series[g][d] = (*generators[g])() / 4294967296.0;
+		mean /= draws;
+		for (int d = 0 ; d < draws ; d++) deviation += ( series[g][d] - mean ) * ( series[g][d] - mean );
+		deviation = sqrt( deviation );
+		for (int d = 0 ; d < draws ; d++) series[g][d] = ( series[g][d] - mean ) / deviation;
+	}
+
+	double worst = 0.0;
+	for (size_t a = 0 ; a < series.size() ; a++)
+		for (size_t b = 0 ; b < a ; b++)
+		{
+			double correlation = 0.0;
+			for (int d = 0 ; d < draws ; d++) correlation += series[a][d] * series[b][d];
+			if ( fabs(correlation) > worst ) worst = fabs(correlation);
+		}
+
+	return worst;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: streams draws creations seed" << endl; exit(1); }
+
+		int streams = (argc > 1) ? atoi(argv[1]) : 16;
+		int draws = (argc > 2) ? atoi(argv[2]) : 10000;
+		int creations = (argc > 3) ? atoi(argv[3]) : 100000;
+		unsigned long seed = (argc > 4) ? atol(argv[4]) : time(NULL);
+
+		// Consecutive seeds, as the workers used to get, against the streams of one seed
+		vector<MTRand_int32*> 	seeded, streamed;
+		for (int s = 0 ; s < streams ; s++)
+		{
+			seeded.push_back( new MTRand_int32( seed + s ) );
+			streamed.push_back( new MTRand_int32() );
+			streamed.back()->seedStream( seed, s );
+		}
+		cout << "Generators\tDraws\tMaxCorrelation(seeds)\tMaxCorrelation(streams)\tExpected" << endl;
+		cout << streams << "\t" << draws << "\t" << maxCorrelation( seeded, draws ) << "\t" << maxCorrelation( streamed, draws )
+			<< "\t~" << 3.0 / sqrt( static_cast<double>(draws) ) << endl;
+		for (int s = 0 ; s < streams ; s++) { delete seeded[s]; delete streamed[s]; }
+
+		// The cost of a new stream, with its first number drawn, against a plain seed
+		MTRand_int32 	random;
+		unsigned long 	sink = 0;
+		Timer timer;
+		timer.start();
+		for (int c = 0 ; c < creations ; c++) { random.seed( seed + c ); sink += random(); }
+		double seeding = timer.elapsed();
+		timer.start();
+		for (int c = 0 ; c < creations ; c++) { random.seedStream( seed, c ); sink += random(); }
+		double streaming = timer.elapsed();
+
+		cout << "Creations\tSeed(usec)\tStream(usec)\t(" << sink % 2 << ")" << endl;
+		cout << creations << "\t" << 1e6 * seeding / creations << "\t" << 1e6 * streaming / creations << endl;
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
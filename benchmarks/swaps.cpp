@@ -0,0 +1,83 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Solves N-Queens once, reassigning variables or swapping their values, and returns the time to solution;
+// `steps' receives the steps of the last iteration
+double solveQueens (int N, bool swaps, unsigned long sampleSize, unsigned long seed, unsigned long& steps)
+{
+	LsProblemManager  pm( 2, seed );
+
+	MaxConflictingVariable 	selectVariable( pm );
+	MinConflictingValue 	minConflictingValue( pm );
+	MinConflictingSwap 	minConflictingSwap( pm, sampleSize );
+
+	LsProblemManager::HillConfiguration conf( &selectVariable, swaps ? static_cast<ValueHeuristic*>(&minConflictingSwap) : &minConflictingValue,
+			1000, 300, 0.1 );
+	// Random walks swap too, and the initial state is a permutation
+	pm.useSwapMoves( swaps );
+
+	NsIntVarArray  Var, VarPlus, VarMinus;
+	for (int i=0;  i < N;  ++i)
+	{
+		Var.push_back( NsIntVar(pm, 0, N-1) );
+		VarPlus.push_back(  Var[i] + i );
+		VarMinus.push_back( Var[i] - i );
+	}
+	pm.add( NsAllDiff(Var) );
+	pm.add( NsAllDiff(VarPlus) );
+	pm.add( NsAllDiff(VarMinus) );
+
+	pm.label(Var, &conf);
+
+	Timer timer;
+	timer.start();
+	pm.nextSolution();
+	steps = conf.maxSteps;
+
+	return timer.elapsed();
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N runs sampleSize seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 100;
+		int runs = (argc > 2) ? atoi(argv[2]) : 5;
+		// Zero tries every partner
+		unsigned long sampleSize = (argc > 3) ? atol(argv[3]) : 0;
+		unsigned long seed = (argc > 4) ? atol(argv[4]) : time(NULL);
+
+		// Time to solution and steps, averaged over `runs' seeds, for both neighbourhoods
+		cout << "N\tMoves\tSampleSize\tAvgTime\tAvgSteps" << endl;
+		for (int swaps = 0 ; swaps <= 1 ; swaps++)
+		{
+			double 		totalTime = 0.0;
+			unsigned long 	totalSteps = 0, steps;
+			for (int r = 0 ; r < runs ; r++)
+			{
+				totalTime += solveQueens( N, swaps, sampleSize, seed + r, steps );
+				totalSteps += steps;
+			}
+			cout << N << "\t" << ( swaps ? "Swap" : "Reassign" ) << "\t" << sampleSize << "\t"
+				<< totalTime / runs << "\t" << totalSteps / runs << endl;
+		}
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
@@ -0,0 +1,111 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Counts the steps, as the runs of the same seed may still differ: naxos orders the violated constraints by address
+struct CountingVariable : public VariableHeuristic
+{
+	VariableHeuristic& 	heuristic;
+	unsigned long 		steps;
+
+	CountingVariable (LsProblemManager& pm_, VariableHeuristic& heuristic_) : VariableHeuristic(pm_), heuristic(heuristic_), steps(0) {}
+
+	VariablePtr select (void)
+	{
+		steps++;
+		return heuristic.select();
+	}
+};
+
+
+// Solves N-Queens with hill climbing, sampled into `trace' unless it is NULL, and returns the time per step
+double timeQueens (int N, unsigned long seed, TraceRecorder* trace)
+{
+	LsProblemManager  pm( 2, seed );
+
+	MaxConflictingVariable 	maxConflicting( pm );
+	CountingVariable 	selectVariable( pm, maxConflicting );
+	MinConflictingValue 	selectValue( pm );
+	LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, 5, 2, 0.0 );
+
+	NsIntVarArray  Var, VarPlus, VarMinus;
+	for (int i=0;  i < N;  ++i)
+	{
+		Var.push_back( NsIntVar(pm, 0, N-1) );
+		VarPlus.push_back(  Var[i] + i );
+		VarMinus.push_back( Var[i] - i );
+	}
+	pm.add( NsAllDiff(Var) );
+	pm.add( NsAllDiff(VarPlus) );
+	pm.add( NsAllDiff(VarMinus) );
+
+	pm.useTrace( trace );
+	pm.label(Var, &conf);
+
+	Timer timer;
+	timer.start();
+	pm.nextSolution();
+
+	return timer.elapsed() / selectVariable.steps;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N runs seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 60;
+		int runs = (argc > 2) ? atoi(argv[2]) : 5;
+		unsigned long seed = (argc > 3) ? atol(argv[3]) : time(NULL);
+
+		// Alternating, so that both see the same machine load; The overhead is the mean of the relative differences
+		// of the time per step, with its 95% confidence interval
+		double 		plainTime = 0.0, tracedTime = 0.0, sum = 0.0, sumSquares = 0.0;
+		unsigned long 	samples = 0;
+		TraceRecorder 	trace;
+		for (int r = 0 ; r < runs ; r++)
+		{
+			double 	plain = timeQueens( N, seed + r, NULL );
+			trace.clear();
+			double 	traced = timeQueens( N, seed + r, &trace );
+			samples += trace.size();
+
+			plainTime += plain;
+			tracedTime += traced;
+			double 	overhead = ( plain > 0.0 ) ? traced / plain - 1.0 : 0.0;
+			sum += overhead;
+			sumSquares += overhead * overhead;
+		}
+		double 		mean = sum / runs;
+		double 		deviation = ( runs > 1 ) ? sqrt( ( sumSquares - runs * mean * mean ) / (runs - 1) ) : 0.0;
+		double 		interval = 1.96 * deviation / sqrt( static_cast<double>(runs) );
+
+		cout << "N\tRuns\tPlainStep(us)\tTracedStep(us)\tOverhead%\t95%CI\tAvgSamples" << endl;
+		cout << N << "\t" << runs << "\t" << 1e6 * plainTime / runs << "\t" << 1e6 * tracedTime / runs << "\t"
+			<< 100.0 * mean << "\t" << 100.0 * interval << "\t" << samples / runs << endl;
+
+		// The trace of the last run
+		ofstream csv( "trace.csv" );
+		trace.writeCsv( csv );
+		ofstream binary( "trace.bin", ios::binary );
+		trace.writeBinary( binary );
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
@@ -0,0 +1,95 @@
+#include <naxos.h>
+#include <walksat.h>
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// Writes a uniform random 3-SAT formula of `variables' variables and `ratio * variables' clauses to `path'
+void writeRandom3Sat (const char* path, unsigned int variables, double ratio, unsigned long seed)
+{
+	MTRand_int32 	random( seed );
+	unsigned int 	clauses = static_cast<unsigned int>( ratio * variables + 0.5 );
+
+	ofstream out( path );
+	out << "c uniform random 3-SAT, seed " << seed << "\n";
+	out << "p cnf " << variables << " " << clauses << "\n";
+	for (unsigned int c = 0 ; c < clauses ; c++)
+	{
+		// Three distinct variables, every one negated with probability 1/2
+		unsigned long 	a = random( variables ), b, d;
+		do b = random( variables ); while ( b == a );
+		do d = random( variables ); while ( d == a || d == b );
+		unsigned long 	chosen[] = {a, b, d};
+		for (int k = 0 ; k < 3 ; k++)
+			out << ( random(2) ? "-" : "" ) << chosen[k] + 1 << " ";
+		out << "0\n";
+	}
+}
+
+
+// Solves the formula in `path' and prints a line of results
+void solveFormula (const char* path, SatProblemManager::Configuration& conf, const char* name, unsigned long seed,
+		double& totalTime, unsigned long& totalFlips, int& solved)
+{
+	SatProblemManager 	sat( seed );
+
+	Timer timer;
+	timer.start();
+	sat.load( path );
+	double loading = timer.elapsed();
+
+	bool satisfied = sat.solve( &conf );
+	double elapsed = timer.elapsed() - loading;
+
+	cout << sat.numVariables() << "\t" << sat.numClauses() << "\t" << name << "\t" << satisfied << "\t" << conf.totalFlips << "\t"
+		<< loading << "\t" << elapsed << "\t" << ( elapsed > 0.0 ? conf.totalFlips / elapsed : 0.0 ) << endl;
+	totalTime += elapsed;
+	totalFlips += conf.totalFlips;
+	solved += satisfied;
+}
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: variables ratio instances maxFlips seed" << endl; exit(1); }
+
+		unsigned int variables = (argc > 1) ? atoi(argv[1]) : 1000;
+		double ratio = (argc > 2) ? atof(argv[2]) : 4.2;
+		int instances = (argc > 3) ? atoi(argv[3]) : 5;
+		unsigned long maxFlips = (argc > 4) ? atol(argv[4]) : 10000000;
+		unsigned long seed = (argc > 5) ? atol(argv[5]) : time(NULL);
+
+		// Near the threshold (4.267) many of the formulas are unsatisfiable; the flips are counted anyway
+		double 		walkTime = 0.0, probTime = 0.0;
+		unsigned long 	walkFlips = 0, probFlips = 0;
+		int 		walkSolved = 0, probSolved = 0;
+		cout << "Variables\tClauses\tAlgorithm\tSolved\tFlips\tLoading\tTime\tFlips/sec" << endl;
+		for (int i = 0 ; i < instances ; i++)
+		{
+			writeRandom3Sat( "random3sat.cnf", variables, ratio, seed + i );
+
+			SatProblemManager::WalkSatConfiguration walkConf( 0.567, maxFlips );
+			solveFormula( "random3sat.cnf", walkConf, "WalkSAT", seed + i, walkTime, walkFlips, walkSolved );
+
+			SatProblemManager::ProbSatConfiguration probConf( 2.38, 1.0, maxFlips );
+			solveFormula( "random3sat.cnf", probConf, "ProbSAT", seed + i, probTime, probFlips, probSolved );
+		}
+		cout << "WalkSAT solved `" << walkSolved << "/" << instances << "' at `" << ( walkTime > 0.0 ? walkFlips / walkTime : 0.0 ) << "' flips/sec" << endl;
+		cout << "ProbSAT solved `" << probSolved << "/" << instances << "' at `" << ( probTime > 0.0 ? probFlips / probTime : 0.0 ) << "' flips/sec" << endl;
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
@@ -0,0 +1,301 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// SHARED ELITE POOL //
+
+// An elite pool shared by the workers, split into shards with a lock each; A worker that finds a shard
+// busy tries the next one, and if all of them are busy it doesn't publish, or restarts from scratch,
+// instead of waiting
+class SharedElitePool : public ElitePool
+{
+
+private:
+
+	struct Shard
+	{
+		ElitePool 		pool;
+		mutex 			lock;
+		// The pool's threshold and best state, readable without the lock
+		atomic<unsigned long> 	threshold, best;
+
+		Shard (unsigned int capacity_) : pool(capacity_), threshold(NsUPLUS_INF), best(NsUPLUS_INF) {}
+	};
+
+	unsigned int 			totalCapacity;
+	vector< unique_ptr<Shard> > 	shards;
+	atomic<unsigned int> 		nextShard;
+
+public:
+
+	atomic<unsigned long> 		published, imported, busy;
+
+	SharedElitePool (unsigned int capacity_, unsigned int shardCount) : ElitePool(0), totalCapacity(capacity_),
+			nextShard(0), published(0), imported(0), busy(0)
+	{
+		if ( shardCount == 0 ) shardCount = 1;
+		for ( unsigned int s = 0 ; s < shardCount ; s++ )
+			shards.push_back( unique_ptr<Shard>( new Shard( (capacity_ + shardCount - 1) / shardCount ) ) );
+	}
+
+	// A state beating any shard may enter the pool
+	unsigned long threshold (void)
+	{
+		unsigned long worst = 0;
+		for ( size_t s = 0 ; s < shards.size() ; s++ )
+			if ( shards[s]->threshold.load( memory_order_relaxed ) > worst ) worst = shards[s]->threshold.load( memory_order_relaxed );
+
+		return worst;
+	}
+
+	bool publish (const StateVector& values, unsigned long conflicts)
+	{
+		unsigned int first = nextShard.fetch_add( 1, memory_order_relaxed );
+		for ( size_t k = 0 ; k < shards.size() ; k++ )
+		{
+			Shard& shard = *shards[ (first + k) % shards.size() ];
+			if ( conflicts >= shard.threshold.load( memory_order_relaxed ) ) continue;
+
+			unique_lock<mutex> guard( shard.lock, try_to_lock );
+			if ( !guard.owns_lock() ) { busy++; continue; }
+
+			bool kept = shard.pool.publish( values, conflicts );
+			shard.threshold.store( shard.pool.threshold(), memory_order_relaxed );
+			shard.best.store( shard.pool.best(), memory_order_relaxed );
+			if ( kept ) published++;
+			return kept;
+		}
+
+		return false;
+	}
+
+	bool sample (StateVector& values, MTRand_int32& random)
+	{
+		unsigned int first = random( shards.size() );
+		for ( size_t k = 0 ; k < shards.size() ; k++ )
+		{
+			Shard& shard = *shards[ (first + k) % shards.size() ];
+
+			unique_lock<mutex> guard( shard.lock, try_to_lock );
+			if ( !guard.owns_lock() ) { busy++; continue; }
+
+			if ( shard.pool.sample( values, random ) )
+			{
+				imported++;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	unsigned long best (void)
+	{
+		unsigned long bestConflicts = NsUPLUS_INF;
+		for ( size_t s = 0 ; s < shards.size() ; s++ )
+			if ( shards[s]->best.load( memory_order_relaxed ) < bestConflicts ) bestConflicts = shards[s]->best.load( memory_order_relaxed );
+
+		return bestConflicts;
+	}
+
+	bool sampleBetter (StateVector& values, MTRand_int32& random, unsigned long conflicts)
+	{
+		unsigned int first = random( shards.size() );
+		for ( size_t k = 0 ; k < shards.size() ; k++ )
+		{
+			Shard& shard = *shards[ (first + k) % shards.size() ];
+			if ( shard.best.load( memory_order_relaxed ) >= conflicts ) continue;
+
+			unique_lock<mutex> guard( shard.lock, try_to_lock );
+			if ( !guard.owns_lock() ) { busy++; continue; }
+
+			if ( shard.pool.sampleBetter( values, random, conflicts ) )
+			{
+				imported++;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	std::ostream& configuration (std::ostream& out)
+	{
+		out << "Shared elite pool capacity: `" << totalCapacity << "' states in `" << shards.size() << "' shards" << endl;
+
+		return out;
+	}
+};
+
+
+// INSTANCES //
+
+// A random graph with a hidden coloring of `colors' colors, and `degree' average degree;
+// Near degree 4.7 for 3 colors the instances are the hardest
+struct Instance
+{
+	int 				nodes;
+	int 				colors;
+	vector< pair<int, int> > 	edges;
+
+	Instance (int nodes_, int colors_, double degree, unsigned long seed) : nodes(nodes_), colors(colors_)
+	{
+		MTRand_int32 	random( seed );
+		MTRand 		probability( seed + 1 );
+
+		vector<int> hidden( nodes );
+		for (int i = 0 ; i < nodes ; i++) hidden[i] = random( colors );
+
+		// Edges only between differently colored nodes, with the probability giving the average degree
+		double p = degree / ( nodes * (colors - 1.0) / colors );
+		for (int i = 0 ; i < nodes ; i++)
+			for (int j = 0 ; j < i ; j++)
+				if ( hidden[i] != hidden[j] && probability() < p ) edges.push_back( make_pair(i, j) );
+	}
+};
+
+
+// WORKERS //
+
+// Thrown out of the search when another worker has found a solution, or the time ran out
+struct Stopped {};
+
+struct StoppableVariable : public VariableHeuristic
+{
+	VariableHeuristic& 	heuristic;
+	const atomic<bool>& 	stop;
+
+	StoppableVariable (LsProblemManager& pm_, VariableHeuristic& heuristic_, const atomic<bool>& stop_) :
+			VariableHeuristic(pm_), heuristic(heuristic_), stop(stop_) {}
+
+	VariablePtr select (void)
+	{
+		if ( stop.load( memory_order_relaxed ) ) throw Stopped();
+		return heuristic.select();
+	}
+
+	bool drawsConflicts (void) { return heuristic.drawsConflicts(); }
+};
+
+
+// Every worker runs its own problem manager on its own copy of the model, with its own stream of the seed
+void work (const Instance& instance, unsigned long seed, unsigned stream, ElitePool* pool, unsigned long importEvery,
+		atomic<bool>& stop, atomic<unsigned long>& restarts)
+{
+	LsProblemManager  pm( 2 );
+	pm.randomStream( seed, stream );
+
+	MaxConflictingVariable 	maxConflicting( pm );
+	StoppableVariable 	selectVariable( pm, maxConflicting, stop );
+	MinConflictingValue 	selectValue( pm );
+	LubyRestartPolicy 	restartPolicy( pm, 500 );
+
+	LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, 1000, 300, 0.05 );
+	// Stagnating workers restart; from a perturbed elite state when cooperating, and when importing
+	// periodically they also move to better elite states in between
+	conf.restartPolicy = &restartPolicy;
+	conf.elitePool = pool;
+	conf.perturbation = instance.nodes / 20 + 1;
+	conf.importEvery = importEvery;
+
+	NsIntVarArray Nodes;
+	for (int i = 0 ; i < instance.nodes ; i++)
+		Nodes.push_back( NsIntVar(pm, 0, instance.colors - 1) );
+	for (size_t e = 0 ; e < instance.edges.size() ; e++)
+		pm.add( Nodes[instance.edges[e].first] != Nodes[instance.edges[e].second] );
+
+	pm.label(Nodes, &conf);
+
+	try {
+		pm.nextSolution();
+		stop = true;
+	} catch (Stopped&) {
+	}
+	restarts += conf.restarts;
+}
+
+
+// Cooperation modes of the workers
+enum Mode { INDEPENDENT, AT_RESTARTS, PERIODIC };
+const char* modeNames[] = { "independent", "restarts", "periodic" };
+
+// Solves `instance' with `threads' workers, and returns the time to the first solution, or `limit' if none
+double solve (const Instance& instance, unsigned threads, Mode mode, unsigned long importEvery, unsigned long seed, double limit,
+		unsigned long& restarts, unsigned long& imported)
+{
+	SharedElitePool 	pool( 4 * threads, (threads + 1) / 2 );
+	atomic<bool> 		stop( false );
+	atomic<unsigned long> 	totalRestarts( 0 );
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	vector<thread> workers;
+	for ( unsigned w = 0 ; w < threads ; w++ )
+		workers.push_back( thread( work, cref(instance), seed, w, mode == INDEPENDENT ? NULL : &pool,
+				mode == PERIODIC ? importEvery : 0, ref(stop), ref(totalRestarts) ) );
+
+	while ( !stop && chrono::duration<double>( chrono::steady_clock::now() - start ).count() < limit )
+		this_thread::sleep_for( chrono::milliseconds(1) );
+	bool solved = stop;
+	stop = true;
+	for ( unsigned w = 0 ; w < threads ; w++ ) workers[w].join();
+
+	double elapsed = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+	restarts = totalRestarts;
+	imported = pool.imported;
+
+	return solved ? elapsed : limit;
+}
+
+
+int main (int argc, char *argv[])
+{
+	if ( argc == 1 ) { cerr << "USAGE: nodes colors degree runs timeLimit seed importEvery" << endl; exit(1); }
+
+	int nodes = (argc > 1) ? atoi(argv[1]) : 300;
+	int colors = (argc > 2) ? atoi(argv[2]) : 3;
+	double degree = (argc > 3) ? atof(argv[3]) : 4.5;
+	int runs = (argc > 4) ? atoi(argv[4]) : 5;
+	double limit = (argc > 5) ? atof(argv[5]) : 60;
+	unsigned long seed = (argc > 6) ? atol(argv[6]) : time(NULL);
+	unsigned long importEvery = (argc > 7) ? atol(argv[7]) : 1000;
+
+	// Average time to the first solution over `runs' instances; unsolved runs count as `limit'
+	cout << "Threads\tMode\tAvgTime\tSolved\tAvgRestarts\tAvgImported" << endl;
+	unsigned threadCounts[] = {1, 2, 4, 8, 16};
+	for ( size_t t = 0 ; t < sizeof(threadCounts) / sizeof(threadCounts[0]) ; t++ )
+	{
+		for ( int mode = INDEPENDENT ; mode <= PERIODIC ; mode++ )
+		{
+			double 		totalTime = 0.0;
+			int 		solved = 0;
+			unsigned long 	totalRestarts = 0, totalImported = 0, restarts, imported;
+			for ( int r = 0 ; r < runs ; r++ )
+			{
+				Instance instance( nodes, colors, degree, seed + 1000 * r );
+				double elapsed = solve( instance, threadCounts[t], Mode(mode), importEvery, seed + r, limit, restarts, imported );
+				totalTime += elapsed;
+				solved += ( elapsed < limit );
+				totalRestarts += restarts;
+				totalImported += imported;
+			}
+			cout << threadCounts[t] << "\t" << modeNames[mode] << "\t" << totalTime / runs << "\t"
+				<< solved << "/" << runs << "\t" << totalRestarts / runs << "\t" << totalImported / runs << endl;
+		}
+	}
+}
@@ -0,0 +1,6 @@
+#! /bin/sh
+
+# Time to solution of hard 3-coloring instances on 1, 2, 4, 8 and 16 threads; independent restarts,
+# restarts from the shared elite pool, and restarts from it plus imports of better elite states every 1000 steps
+./cooperative 300 3 4.5 5 60 1325772160 1000
+./cooperative 500 3 4.6 5 120 1325772160 1000
@@ -63,9 +63,12 @@ int  main (int argc, char *argv[])
 			//BestImprovementVariable 	selectVariable( pm );
 			//BestImprovementValue 		selectValue( pm, selectVariable );
 			LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, stateRepeats, avoidAttempts, walkProb );
+			// With Constraint Weighting (breakout) //
+			//LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, stateRepeats, avoidAttempts, walkProb, 1 );
 
 			// PROBLEM STATEMENT //
 			NsIntVarArray Nodes;
+			ConstraintGraph constraintGraph(N);
 
 			for(i=0; i<N; ++i)
 				Nodes.push_back( NsIntVar(pm, 0, k) );
@@ -73,7 +76,24 @@ int  main (int argc, char *argv[])
 			for(i=0; i<N; ++i)
 				for(j=0; j<i; ++j)
 					if(graph[i][j])
+					{
 						pm.add( Nodes[i] != Nodes[j] );
+						constraintGraph[i].push_back(j);
+						constraintGraph[j].push_back(i);
+					}
+
+			// Copied into the compact model at labeling
+			pm.useConstraintGraph( constraintGraph );
+
+			// INITIALIZATION (random if none) //
+			//DsaturInitializer 		initializer( pm );
+			//GreedyInitializer 		initializer( pm, GreedyInitializer::DEGREE_ORDER );
+			//initializer.useDifferentNeighbours();
+			//pm.useInitializer( &initializer );
+
+			// SYMMETRY (permutations of the colors count as one solution) //
+			//ColorCanonicalizer 		canonicalizer;
+			//pm.useCanonicalizer( &canonicalizer );
 
 			// LABELING //
 			pm.label(Nodes, &conf);
@@ -85,6 +105,7 @@ int  main (int argc, char *argv[])
 				pm.nextSolution();
 				pm.solutionToString( cout );
 				pm.statistics( cout );
+				//pm.memoryReport( cout );
 			}
 
 			k++;
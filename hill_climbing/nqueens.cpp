@@ -34,10 +34,27 @@ int main (int argc, char *argv[])
 		//SmallestDomainVariable 	selectVariable( pm );
 		MinConflictingValue 		selectValue( pm );
 		//RandomValue 			selectValue( pm );
+		// Swap neighbourhood; rows stay distinct, only the diagonals conflict //
+		//MinConflictingSwap 		selectValue( pm );
+		//pm.useSwapMoves();
 		// NOTE: Must be used together //
 		//BestImprovementVariable 	selectVariable( pm );
 		//BestImprovementValue 		selectValue( pm, selectVariable );
 		LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, stateRepeats, avoidAttempts, walkProb );
+		// With Constraint Weighting (breakout) //
+		//LsProblemManager::HillConfiguration conf( &selectVariable, &selectValue, stateRepeats, avoidAttempts, walkProb, 1 );
+		// With Guided Local Search, penalizing (variable, value) assignments at local minima //
+		//conf.penaltyLambda = 1;
+		// Iterated Local Search instead of restarts, perturbing the accepted optimum by N/20 moves or more //
+		//conf.iteratedPerturbation = N / 20 + 1;
+		// Restart policy and elite pool warm starts (optional) //
+		//LubyRestartPolicy 		restartPolicy( pm, 100 );
+		//GeometricRestartPolicy 	restartPolicy( pm, 100, 1.5 );
+		//FixedRestartPolicy 		restartPolicy( pm, 1000 );
+		//conf.restartPolicy = &restartPolicy;
+		//ElitePool 			elitePool( 8 );
+		//conf.elitePool = &elitePool;
+		//conf.perturbation = N / 10;
 
 		// SIMULATED ANNEALING //
 		//LogarithmicScheduler scheduler( pm, 3, 56 );
@@ -56,6 +73,27 @@ int main (int argc, char *argv[])
 		pm.add( NsAllDiff(VarPlus) );
 		pm.add( NsAllDiff(VarMinus) );
 
+		// INITIALIZATION (random if none) //
+		//GreedyInitializer 		initializer( pm, GreedyInitializer::RANDOM_ORDER, 32 );
+		//pm.useInitializer( &initializer );
+		// The conflicts of the greedy counted from the three AllDiff, instead of asked from naxos //
+		//DifferenceGroups 		groups( 3 );
+		//for (int i=0;  i < N;  ++i)
+		//{
+		//	groups[0].push_back( make_pair(i, 0) );
+		//	groups[1].push_back( make_pair(i, i) );
+		//	groups[2].push_back( make_pair(i, -i) );
+		//}
+		//initializer.useDifferenceGroups( &groups );
+
+		// OUTPUT (besides solutionToString) //
+		//TextSolutionWriter 		writer( cout );
+		//pm.onSolution( &writer );
+		// Enumeration: each solution found near the previous one //
+		//pm.enumerate( 4 );
+		//DihedralCanonicalizer 	canonicalizer;
+		//pm.useCanonicalizer( &canonicalizer );
+
 		// LABELING //
 		pm.label(Var, &conf);
 
@@ -67,6 +105,7 @@ int main (int argc, char *argv[])
 			pm.nextSolution();
 			pm.solutionToString( cout );
 			pm.statistics( cout );
+			//pm.memoryReport( cout );
 		}
 
 	} catch (exception& exc) {
@@ -0,0 +1,15 @@
+#! /bin/sh
+
+# The only parameter is the history length; The tabu tenure is fixed, as for Simulated Annealing
+N=25
+while  [ $N  -le  300 ]
+do
+	echo
+
+	for history in 1 10 50 200 1000
+	do
+		./nqueens $N $history 3 1325772160
+	done
+
+	N=`expr $N + 25`
+done
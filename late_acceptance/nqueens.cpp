@@ -0,0 +1,58 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <ctime>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+int main (int argc, char *argv[])
+{
+	try {
+
+		if ( argc == 1 ) { cerr << "USAGE: N historyLength tabuTenure seed" << endl; exit(1); }
+
+		int N = (argc > 1) ? atoi(argv[1]) : 8;
+		unsigned long historyLength = (argc > 2) ? atol(argv[2]) : 50;
+		unsigned long tabuTenure = (argc > 3) ? atol(argv[3]) : 2;
+		unsigned long seed = (argc > 4) ? atol(argv[4]) : time(NULL);
+
+		LsProblemManager  pm( tabuTenure, seed );
+
+		// LATE ACCEPTANCE HILL CLIMBING //
+		LsProblemManager::LateAcceptanceConfiguration conf( historyLength );
+
+		// PROBLEM STATEMENT //
+		NsIntVarArray  Var, VarPlus, VarMinus;
+		for (int i=0;  i < N;  ++i)
+		{
+			Var.push_back( NsIntVar(pm, 0, N-1) );
+			VarPlus.push_back(  Var[i] + i );
+			VarMinus.push_back( Var[i] - i );
+		}
+		pm.add( NsAllDiff(Var) );
+		pm.add( NsAllDiff(VarPlus) );
+		pm.add( NsAllDiff(VarMinus) );
+
+		// LABELING //
+		pm.label(Var, &conf);
+
+		// SOLVING //
+		pm.configuration( cout );
+		//while (true)
+		{
+			pm.nextSolution();
+			pm.solutionToString( cout );
+			pm.statistics( cout );
+		}
+
+	} catch (exception& exc) {
+		cerr << exc.what() << "\n";
+	} catch (...) {
+		cerr << "Unknown exception" << "\n";
+	}
+}
@@ -2,6 +2,20 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <set>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+
+#ifdef LOCAL_S_MAPPED_WRITER
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace localS;
 
@@ -12,17 +26,31 @@ void LsProblemManager::label (naxos::NsIntVarArray& varArray_, Configuration* co
 	conf 		= conf_;
 
 	varArray->lsLabeling();
+
+	compact.build( *varArray, constraintGraph );
+	constraintGraph = NULL;
+	tabuAssignments.clear();
+	tabuCounts.assign( varArray->size(), 0 );
 }
 
 
 std::ostream& LsProblemManager::solutionToString (std::ostream& out)
 {
-	out << "\nSolution: [";
-	for ( naxos::NsIndex i = 0, size = varArray->size() ; i < size ; i++ )
+	naxos::NsIndex 	size = compact.values.size();
+
+	// Formatted into one buffer and written at once; "[value] " takes at most 14 characters
+	outputBuffer.resize( size * 14 + 1 );
+	char* 	p = &outputBuffer[0];
+	for ( naxos::NsIndex i = 0 ; i < size ; i++ )
 	{
-		out << "[" << (*varArray)[i].lsValue() << "]";
-		if ( i != size - 1 ) out << " ";
+		*p++ = '[';
+		p = TextSolutionWriter::format( p, compact.values[i] );
+		*p++ = ']';
+		if ( i != size - 1 ) *p++ = ' ';
 	}
+
+	out << "\nSolution: [";
+	out.write( &outputBuffer[0], p - &outputBuffer[0] );
 	out << "]" << std::endl;
 
 	return out;
@@ -35,24 +63,90 @@ void LsProblemManager::nextSolution (void)
 
 	Timer timer;
 	std::string hash;
+	perturbMoves = enumerationMoves;
 	while ( true )
 	{
 		// Initialize at the beginning of each search process
 		globalMinConflicts = -1;
 
-		if ( !previousSolutions.empty() ) reset();
+		if ( !previousSolutions.empty() && !startPending )
+		{
+			if ( enumerationMoves == 0 ) 	reset();
+			else 				perturbPending = true;
+		}
 
 		timer.start(); 				// Start timing
 		if 	( conf->algorithm() == HILL ) 		solveHill();
 		else if ( conf->algorithm() == ANNEALING ) 	solveAnnealing();
+		else if ( conf->algorithm() == LATE_ACCEPTANCE ) solveLateAcceptance();
 		elapsedTime = timer.elapsed(); 		// Get elapsed time
+		enumerationTime += elapsedTime;
 
-		hash = hashState(0, 0);
+		hash = hashSolution();
 		// Current solution is a new one
-		if ( previousSolutions.search( hash ) == 0 ) break;
-		std::cerr << "Skipping solution with hash: " << hash << " (already found)" << std::endl;
+		if ( previousSolutions.find( hash ) == previousSolutions.end() && isDiverse() ) break;
+
+		rejectedSolutions++;
+		if ( enumerationMoves == 0 )
+			std::cerr << "Skipping solution with hash: " << hash << " (already found)" << std::endl;
+		// Move further away from the solutions found
+		else if ( perturbMoves < varArray->size() )
+			perturbMoves *= 2;
+	}
+	previousSolutions.insert( hash );
+	distinctSolutions++;
+	if ( minDistance > 1 ) recentSolutions.push( compact.values );
+
+	if ( solutionCallback != NULL && !compact.values.empty() ) (*solutionCallback)( &compact.values[0], compact.values.size() );
+}
+
+
+bool LsProblemManager::isDiverse (void)
+{
+	if ( minDistance <= 1 ) return true;
+
+	for ( ActiveWindow<StateVector>::iterator it = recentSolutions.begin() ; it != recentSolutions.end() ; it++ )
+	{
+		unsigned long distance = 0;
+		for ( naxos::NsIndex i = 0, size = compact.values.size() ; i < size && distance < minDistance ; i++ )
+			if ( compact.values[i] != (*it)[i] ) distance++;
+		if ( distance < minDistance ) return false;
 	}
-	previousSolutions.push( hash );
+
+	return true;
+}
+
+
+void LsProblemManager::enumerate (unsigned long moves, unsigned long minDistance_, unsigned long window)
+{
+	enumerationMoves = moves;
+	minDistance = minDistance_;
+	recentSolutions.width( window );
+}
+
+
+void LsProblemManager::startFrom (const StateVector& values)
+{
+	naxos::assert_Ns( varArray != NULL , "LsProblemManager::startFrom: You must first call `LsProblemManager::label'" );
+	naxos::assert_Ns( values.size() == varArray->size(), "LsProblemManager::startFrom: Wrong number of values" );
+
+	if ( assigned ) reset();
+	startState.assign( values.begin(), values.end() );
+	startPending = true;
+}
+
+
+void LsProblemManager::clearSolutions (void)
+{
+	// Unassign the variables of the last solution, as the next search expects
+	if ( !previousSolutions.empty() ) reset();
+
+	previousSolutions.clear();
+	recentSolutions.clear();
+	perturbPending = false;
+	distinctSolutions = 0;
+	rejectedSolutions = 0;
+	enumerationTime = 0.0;
 }
 
 
@@ -61,6 +155,17 @@ void LsProblemManager::solveHill (void)
 	using namespace std;
 	using namespace naxos;
 
+	HillConfiguration* hConf = static_cast<HillConfiguration*> (conf);
+
+	// Weights and penalties are learnt anew for every solution
+	weightIncrement = hConf->weightIncrement;
+	constraintWeights.clear();
+	penaltyLambda = hConf->penaltyLambda;
+	resetPenalties();
+	if ( resumePending ) resumeLearning();
+	// Conflicting variables are drawn at random only on walks, unless the variable heuristic draws them on every step
+	trackConflicts = hConf->variableHeuristic->drawsConflicts();
+
 	initialize();
 
 	// Force a random walk
@@ -72,11 +177,36 @@ void LsProblemManager::solveHill (void)
 	// For the random walks
 	RandomVariable 	randomVariable( *this );
 	RandomValue 	randomValue( *this );
+	RandomSwap 	randomSwap( *this );
+	ValueHeuristic& walkValue = swapMoves ? static_cast<ValueHeuristic&>(randomSwap) : randomValue;
 	// Keep the previous states (hash) with the same number of conflicting constraints
-	ActiveWindow<std::string> previousStates;
-
-	HillConfiguration* hConf = static_cast<HillConfiguration*> (conf);
-	hConf->steps = 0; hConf->maxSteps = 0; hConf->restarts = 0;
+	previousStates.clear();
+
+	hConf->steps = 0; hConf->maxSteps = 0; hConf->restarts = 0; hConf->eliteRestarts = 0; hConf->eliteImports = 0; hConf->weightIncreases = 0; hConf->penaltyIncreases = 0;
+	hConf->iterations = 0; hConf->acceptedIterations = 0;
+	// No local optimum accepted yet
+	iteratedJournal.clear();
+	iteratedJournalValid = false;
+	iteratedConflicts = naxos::NsUPLUS_INF;
+	iteratedMoves = hConf->iteratedPerturbation;
+	iteratedOptima.clear();
+	if ( resumePending )
+	{
+		hConf->loadCounters( checkpointData.counters );
+		naxos::assert_Ns( checkpointData.restartPolicy == ( hConf->restartPolicy != NULL )
+				&& ( hConf->restartPolicy == NULL || (*hConf->restartPolicy)[hConf->restarts] == checkpointData.restartLimit ),
+				"LsProblemManager::solveHill: The checkpoint is of another restart policy" );
+		iteratedConflicts = checkpointData.iteratedConflicts;
+		if ( iteratedConflicts != naxos::NsUPLUS_INF )
+		{
+			naxos::assert_Ns( hConf->iteratedPerturbation != 0, "LsProblemManager::solveHill: The checkpoint is of Iterated Local Search" );
+			iteratedMoves = checkpointData.iteratedMoves;
+			iteratedState = checkpointData.iteratedState;
+		}
+		for ( std::vector<StateHash>::iterator it = checkpointData.iteratedOptima.begin() ; it != checkpointData.iteratedOptima.end() ; it++ )
+			iteratedOptima.push( *it );
+		resumePending = false;
+	}
 	// Repeat till a solution is found
 	while ( !lsViolatedConstraints().empty() )
 	{
@@ -89,15 +219,29 @@ void LsProblemManager::solveHill (void)
 		{
 			//std::cerr << "\t(Random Walk...)" << std::endl;
 			selectedVariablePtr = randomVariable.select();
-			randomValue.select( *selectedVariablePtr );
+			walkValue.select( *selectedVariablePtr );
 			doRandom = false;
 		}
 		// Else (with probability 1-walkProb) perform a standard step
 		else
 		{
 			//std::cerr << "\t(Standard Walk...)" << std::endl;
+			unsigned long previousConflicts = conflicts();
 			selectedVariablePtr = hConf->variableHeuristic->select();
 			hConf->valueHeuristic->select( *selectedVariablePtr );
+
+			// No improvement means a local minimum; make its violated constraints heavier
+			if ( weightIncrement != 0 && conflicts() >= previousConflicts && !lsViolatedConstraints().empty() )
+			{
+				increaseWeights();
+				hConf->weightIncreases++;
+			}
+			// Guided Local Search; penalize the assignments of most utility
+			if ( penaltyLambda != 0 && conflicts() >= previousConflicts && !lsViolatedConstraints().empty() )
+			{
+				increasePenalties();
+				hConf->penaltyIncreases++;
+			}
 		}
 
 		// Keep in previousStates only states with the same number of conflicting constraints
@@ -107,27 +251,25 @@ void LsProblemManager::solveHill (void)
 			previousStates.clear();
 		}
 
-		string stateHash = hashState(selectedVariablePtr->lsIndex(), selectedVariablePtr->lsValue());
+		StateHash stateHash = hashStep(selectedVariablePtr->lsIndex(), selectedVariablePtr->lsValue());
 		//std::cerr << "Conflicts: " << lsViolatedConstraints().size() << " | Var: " << selectedVariablePtr->lsIndex();
 		//std::cerr << " --> Value: " <<  selectedVariablePtr->lsValue() << " | " << stateHash << " || " << previousStates.size() << std::endl;
 		previousStates.push( stateHash );
 
 		hConf->steps++;
+		checkpointStep( 0, 0 );
+		if ( trace != NULL && trace->tick() ) trace->record( lsViolatedConstraints().size(), 0.0 );
+		if ( hConf->importEvery != 0 && hConf->elitePool != NULL && hConf->steps % hConf->importEvery == 0
+				&& !lsViolatedConstraints().empty() )
+			importElite( hConf );
+
+		bool restart = false;
 		// States in active window repeat themselves; restart the process
 		if ( previousStates.search( stateHash ) >= hConf->maxStateRepeats )
 		{
 			if ( attempts++ == hConf->maxAvoidAttempts )
 			{
-				//cerr << "Restarting...\n" << endl;
-				hConf->restarts++;
-				hConf->maxSteps = (hConf->maxSteps < hConf->steps ? hConf->steps : hConf->maxSteps);
-				hConf->steps = 0;
-				doRandom = false;
-				attempts = 0;
-				previousStates.clear();
-
-				reset();
-				initialize();
+				restart = true;
 			}
 			else
 			{
@@ -137,7 +279,28 @@ void LsProblemManager::solveHill (void)
 				previousStates.clear();
 			}
 		}
+		// The steps allowed by the restart policy ran out
+		if ( hConf->restartPolicy != NULL && !lsViolatedConstraints().empty()
+				&& hConf->steps >= (*hConf->restartPolicy)[hConf->restarts] )
+			restart = true;
+
+		if ( restart )
+		{
+			//cerr << "Restarting...\n" << endl;
+			hConf->maxSteps = (hConf->maxSteps < hConf->steps ? hConf->steps : hConf->maxSteps);
+			hConf->steps = 0;
+			doRandom = false;
+			attempts = 0;
+			previousStates.clear();
+
+			if ( hConf->iteratedPerturbation != 0 ) iterateHill( hConf );
+			else 					restartHill( hConf );
+			if ( trace != NULL ) trace->restarted();
+		}
 	}
+	iteratedJournal.clear();
+	iteratedJournalValid = false;
+	if ( trace != NULL ) trace->record( 0, 0.0 );
 	// Update maxSteps
 	if ( hConf->steps > hConf->maxSteps ) hConf->maxSteps = hConf->steps;
 	// If no restart occured
@@ -145,6 +308,124 @@ void LsProblemManager::solveHill (void)
 }
 
 
+void LsProblemManager::restartHill (HillConfiguration* hConf)
+{
+	hConf->restarts++;
+
+	if ( hConf->elitePool != NULL )
+	{
+		// Offer the state the iteration ended at; copy it only if the pool would keep it
+		unsigned long currentConflicts = lsViolatedConstraints().size();
+		if ( currentConflicts < hConf->elitePool->threshold() )
+		{
+			captureState( stateBuffer );
+			hConf->elitePool->publish( stateBuffer, currentConflicts );
+		}
+
+		// Move to a perturbed elite state, reassigning only the variables that differ
+		if ( hConf->elitePool->sample( stateBuffer, random ) )
+		{
+			restoreState( stateBuffer );
+			perturb( hConf->perturbation );
+			clearTabu();
+			tabuSwaps.clear();
+			hConf->eliteRestarts++;
+			return;
+		}
+	}
+
+	reset();
+	initialize();
+}
+
+
+void LsProblemManager::importElite (HillConfiguration* hConf)
+{
+	unsigned long currentConflicts = lsViolatedConstraints().size();
+	if ( currentConflicts < hConf->elitePool->threshold() )
+	{
+		captureState( stateBuffer );
+		hConf->elitePool->publish( stateBuffer, currentConflicts );
+	}
+
+	// Continue from a better elite state as it is; the search goes on without restarting
+	if ( hConf->elitePool->best() < currentConflicts && hConf->elitePool->sampleBetter( stateBuffer, random, currentConflicts ) )
+	{
+		restoreState( stateBuffer );
+		clearTabu();
+		tabuSwaps.clear();
+		previousStates.clear();
+		hConf->eliteImports++;
+	}
+}
+
+
+void LsProblemManager::iterateHill (HillConfiguration* hConf)
+{
+	hConf->iterations++;
+
+	// Acceptance criterion; the local optimum the search stagnated at replaces the accepted one if it is no worse,
+	// otherwise the search returns to the accepted one, undoing only the changes since then
+	unsigned long 	currentConflicts = lsViolatedConstraints().size();
+	StateHash 	optimumHash = currentHash;
+	if ( currentConflicts <= iteratedConflicts )
+	{
+		iteratedConflicts = currentConflicts;
+		hConf->acceptedIterations++;
+	}
+	else if ( iteratedJournalValid )
+	{
+		iteratedJournalValid = false;
+		for ( std::vector<std::pair<naxos::NsIndex, int> >::reverse_iterator it = iteratedJournal.rbegin() ; it != iteratedJournal.rend() ; it++ )
+			applyAssignment( std::make_pair(&(*varArray)[it->first], static_cast<naxos::NsInt>(it->second)) );
+	}
+	else
+	{
+		restoreState( iteratedState );
+	}
+	iteratedJournal.clear();
+	iteratedJournalValid = true;
+
+	// Falling back to an optimum met lately means the perturbation was too weak to leave its basin
+	if ( iteratedOptima.find( optimumHash ) )
+	{
+		iteratedMoves *= 2;
+		if ( iteratedMoves > varArray->size() ) iteratedMoves = varArray->size();
+	}
+	else
+	{
+		iteratedMoves = hConf->iteratedPerturbation;
+	}
+	iteratedOptima.push( optimumHash );
+
+	perturb( iteratedMoves );
+	clearTabu();
+	tabuSwaps.clear();
+}
+
+
+void LsProblemManager::perturb (unsigned long moves)
+{
+	using namespace naxos;
+
+	NsIntVarArray& 	variables = *varArray;
+
+	for ( unsigned long move = 0 ; move < moves ; move++ )
+	{
+		NsIntVar& 	variable = variables[ random( variables.size() ) ];
+		if ( swapMoves )
+		{
+			NsIntVar& 	partner = variables[ random( variables.size() ) ];
+			if ( partner.contains( variable.lsValue() ) && variable.contains( partner.lsValue() ) ) applySwap( &variable, &partner );
+			continue;
+		}
+		NsInt 		currentValue = randomValue( variable );
+
+		if ( currentValue != variable.lsValue() ) applyAssignment( std::make_pair(&variable, currentValue) );
+	}
+}
+
+
 void LsProblemManager::solveAnnealing (void)
 {
 	using namespace std;
@@ -152,7 +433,11 @@ void LsProblemManager::solveAnnealing (void)
 
 	// For the random walks
 	RandomVariable 	randomVariable( *this );
-	RandomValue 	randomValue( *this );
+
+	// Annealing works on the plain number of violated constraints, and draws a conflicting variable on every step
+	weightIncrement = 0;
+	penaltyLambda = 0;
+	trackConflicts = true;
 
 	initialize();
 
@@ -160,11 +445,25 @@ void LsProblemManager::solveAnnealing (void)
 
 	double T = 0.0;
 	unsigned long stableSteps = aConf->scheduler->stablePeriod();
+	unsigned long t = 0, k = 0;
 	aConf->steps = 0; aConf->restarts = 0;
-	for (unsigned long t = 0, k = 0 ; t < naxos::NsUPLUS_INF ; k = (k + 1) % stableSteps )
+
+	// Continue from the scheduler position of a restored checkpoint
+	bool resumeSchedule = resumePending;
+	if ( resumePending )
+	{
+		aConf->loadCounters( checkpointData.counters );
+		t = checkpointData.schedulerStep;
+		k = checkpointData.stableStep;
+		aConf->scheduler->resume( t );
+		T = (*aConf->scheduler)[t];
+		resumePending = false;
+	}
+
+	for ( ; t < naxos::NsUPLUS_INF ; k = (k + 1) % stableSteps )
 	{
 		// The first time of the `stableSteps' repeats
-		if ( k == 0 )
+		if ( k == 0 && !resumeSchedule )
 		{
 			t++;
 			// Get Temperature from scheduler for the current step
@@ -174,34 +473,42 @@ void LsProblemManager::solveAnnealing (void)
 			{
 				t = 1 ;
 				aConf->restarts++;
+				if ( trace != NULL ) trace->restarted();
 				continue;
 			}
 		}
 
+		resumeSchedule = false;
+		checkpointStep( t, k );
+		if ( trace != NULL && trace->tick() ) trace->record( lsViolatedConstraints().size(), T );
+
 		// Select variable and value at random
 		VariablePtr selectedVariablePtr = randomVariable.select();
 
-		NsInt 	currentValue = selectedVariablePtr->lsValue();
 		int 	currentConflicts = lsViolatedConstraints().size();
 
-		NsInt 	selectedValue = randomValue.select( *selectedVariablePtr );
+		// No other value, or the move is tabu
+		if ( !tryRandomMove( selectedVariablePtr ) ) continue;
 		int 	nextConflicts = lsViolatedConstraints().size();
-		
-		int 	de = nextConflicts - currentConflicts;
 
-		// Same value selected
-		if ( currentValue == selectedValue ) continue;
+		int 	de = nextConflicts - currentConflicts;
 
 		// Found a solution
 		if ( nextConflicts == 0 )
 		{
+			acceptMove();
 			// Record total steps
 			aConf->steps = (t - 1) * stableSteps + (k + 1) ;
+			if ( trace != NULL ) trace->record( 0, T );
 			break;
 		}
 
 		// Current move is an improvement; accept it
-		if ( de <= 0 ) continue;
+		if ( de <= 0 )
+		{
+			acceptMove();
+			continue;
+		}
 
 		// Else accept current move with probability e^(de/T)
 
@@ -211,85 +518,1540 @@ void LsProblemManager::solveAnnealing (void)
 
 		// Acceptance with probability e^(de/T) means threshold > decay; otherwise undo the last assignment
 		if ( threshold >= decay )
+			rejectRandomMove();
+		else
+			acceptMove();
+	}
+}
+
+
+
+void LsProblemManager::solveLateAcceptance (void)
+{
+	using namespace naxos;
+
+	// For the random moves
+	RandomVariable 	randomVariable( *this );
+
+	// Late Acceptance works on the plain number of violated constraints, and draws a conflicting variable on every step
+	weightIncrement = 0;
+	penaltyLambda = 0;
+	trackConflicts = true;
+
+	initialize();
+
+	LateAcceptanceConfiguration* lConf = static_cast<LateAcceptanceConfiguration*> (conf);
+
+	// The history starts with the initial conflicts, or as it was saved
+	unsigned long 	currentConflicts = lsViolatedConstraints().size();
+	lateHistory.assign( lConf->historyLength, currentConflicts );
+	lConf->steps = 0; lConf->acceptedSteps = 0;
+	if ( resumePending )
+	{
+		lConf->loadCounters( checkpointData.counters );
+		// None when saved before the search started
+		naxos::assert_Ns( checkpointData.lateHistory.empty() || checkpointData.lateHistory.size() == lConf->historyLength,
+				"LsProblemManager::solveLateAcceptance: The checkpoint is of another history length" );
+		if ( !checkpointData.lateHistory.empty() ) lateHistory = checkpointData.lateHistory;
+		resumePending = false;
+	}
+	unsigned long 	position = lConf->steps % lConf->historyLength;
+
+	while ( currentConflicts != 0 )
+	{
+		VariablePtr 	selectedVariablePtr = randomVariable.select();
+
+		lConf->steps++;
+
+		// Accept if no worse than now, or than `historyLength' steps ago; otherwise undo the assignment
+		if ( tryRandomMove( selectedVariablePtr ) )
 		{
-			revertToAssignment( make_pair(selectedVariablePtr, currentValue) );
+			unsigned long 	nextConflicts = lsViolatedConstraints().size();
+			if ( nextConflicts <= currentConflicts || nextConflicts <= lateHistory[position] )
+			{
+				currentConflicts = nextConflicts;
+				lConf->acceptedSteps++;
+				acceptMove();
+			}
+			else
+			{
+				rejectRandomMove();
+			}
 		}
+
+		lateHistory[position] = currentConflicts;
+		if ( ++position == lConf->historyLength ) position = 0;
+
+		checkpointStep( lConf->steps, 0 );
+		if ( trace != NULL && trace->tick() ) trace->record( currentConflicts, 0.0 );
 	}
+	if ( trace != NULL ) trace->record( 0, 0.0 );
 }
 
 
 
-////////////////////////////////////// Various Statistics //////////////////////////////////////
+void LsProblemManager::increaseWeights (void)
+{
+	const ConfConstraints& violatedList = lsViolatedConstraints();
+	// The constraints over the same variables share a weight, increased once
+	constraintIndex.startWalk();
+	for ( ConfConstraints::const_iterator it = violatedList.begin() ; it != violatedList.end() ; it++ )
+	{
+		unsigned long& 	weight = constraintWeight( *it );
+		if ( constraintIndex.firstInWalk( constraintIndex.id( *it ) ) ) weight += weightIncrement;
+	}
+	weightedConflicts = 0;
+	for ( ConfConstraints::const_iterator it = violatedList.begin() ; it != violatedList.end() ; it++ )
+		weightedConflicts += constraintWeight( *it );
+
+	// The weights of the cached variable's constraints may have changed
+	cachedVariable = NULL;
+}
 
 
-std::ostream& LsProblemManager::configuration (std::ostream& out)
+void LsProblemManager::resetPenalties (void)
 {
-	out << std::endl;
-	out << "------------------------------------------------------" << std::endl;
-	out << "---------------------Configuration--------------------" << std::endl;
-	out << "------------------------------------------------------" << std::endl;
-	out << "Random generator running with seed: `" << seed << "'" << std::endl;
-	out << "Tabu Tenure: `" << tabuTenure << "' states" << std::endl;
-	// Print configuration parameters specific for the algorithm used
-	conf->configuration(out);
-	out << "------------------------------------------------------" << std::endl;
+	if ( penaltyLambda == 0 ) return;
+	// The storage is kept across solves, and only the variables penalized in the last one are cleared
+	if ( penalties.size() != compact.domains.size() )
+	{
+		penalties.clear();
+		penalties.resize( compact.domains.size() );
+		penalizedVariables.clear();
+	}
+	for ( std::vector<naxos::NsIndex>::const_iterator it = penalizedVariables.begin() ; it != penalizedVariables.end() ; ++it )
+		penalties[*it].clear();
+	penalizedVariables.clear();
+	currentPenalty = 0;
+}
 
-	return out;
+void LsProblemManager::penalize (naxos::NsIndex i, int value)
+{
+	FeaturePenalties& 	features = penalties[i];
+	if ( features.empty() ) penalizedVariables.push_back( i );
+	for ( FeaturePenalties::iterator it = features.begin() ; it != features.end() ; ++it )
+		if ( it->first == value ) { it->second++; return; }
+	features.push_back( std::make_pair(value, 1UL) );
 }
 
-std::ostream& LsProblemManager::statistics (std::ostream& out)
+void LsProblemManager::increasePenalties (void)
 {
-	out << std::endl;
-	out << "------------------------------------------------------" << std::endl;
-	out << "-----------------Solution  Statistics-----------------" << std::endl;
-	out << "------------------------------------------------------" << std::endl;
-	out << "Elapsed time: `" << elapsedTime << "' sec" << std::endl;
-	// Print statistics specific for the algorithm used
-	conf->statistics(out);
-	out << "------------------------------------------------------" << std::endl;
+	// The feature of a conflicting variable is its current assignment, costing its violated constraints;
+	// Its utility is cost / (1 + penalty), and the features of the greatest utility are penalized
+	std::vector<VariablePtr>& 	maxVariables = scratchVariables;
+	maxVariables.clear();
+	unsigned long 		maxCost = 0, maxPenalty = 0;
+	const ConfVariables& 	conflictSet = lsConflictingVars();
+	for ( ConfVariables::const_iterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+	{
+		naxos::NsIndex 	index = (*it)->lsIndex();
+		unsigned long 	cost = (*it)->lsViolatedConstraints().size();
+		unsigned long 	featurePenalty = penalty( index, compact.values[index] );
 
-	return out;
+		// Compared as cost * (1 + maxPenalty) against maxCost * (1 + penalty), without dividing
+		unsigned long 	utility = cost * (1 + maxPenalty), maxUtility = maxCost * (1 + featurePenalty);
+		if ( utility > maxUtility )
+		{
+			maxCost = cost;
+			maxPenalty = featurePenalty;
+			maxVariables.clear();
+		}
+		if ( utility >= maxUtility ) maxVariables.push_back( *it );
+	}
+
+	for ( std::vector<VariablePtr>::iterator it = maxVariables.begin() ; it != maxVariables.end() ; it++ )
+	{
+		naxos::NsIndex 	index = (*it)->lsIndex();
+		penalize( index, compact.values[index] );
+		currentPenalty++;
+	}
 }
 
 
-std::ostream& LsProblemManager::HillConfiguration::configuration (std::ostream& out)
+
+unsigned long ElitePool::threshold (void)
 {
-	out << "Algorithm used: Hill Climbing" << std::endl;
-	out << "Active Window allowing state repetitions: `" << maxStateRepeats << "' times" << std::endl;
-	out << "Max Attempts to avoid restart: `" << maxAvoidAttempts << "' times" << std:: endl;
-	out << "Walking Probability: `" << walkProb << "'" << std::endl;
-	// Print configuration parameters specific for the heuristics used
-	variableHeuristic->configuration(out);
-	valueHeuristic->configuration(out);
+	if ( states.size() < capacity ) return naxos::NsUPLUS_INF;
 
-	return out;
+	unsigned long worstConflicts = 0;
+	for ( std::vector<EliteState>::iterator it = states.begin() ; it != states.end() ; it++ )
+		if ( it->conflicts > worstConflicts ) worstConflicts = it->conflicts;
+
+	return worstConflicts;
 }
 
-std::ostream& LsProblemManager::HillConfiguration::statistics (std::ostream& out)
+
+bool ElitePool::publish (const StateVector& values, unsigned long conflicts)
 {
-	out << "Restarted: `" << restarts << "' times" << std::endl;
-	out << "Max Steps ever reached: `" << maxSteps << "' steps" << std::endl;
-	out << "In last iteration used: `" << steps << "' steps" << std::endl;
+	if ( capacity == 0 ) return false;
 
-	return out;
+	std::vector<EliteState>::iterator worst = states.begin();
+	for ( std::vector<EliteState>::iterator it = states.begin() ; it != states.end() ; it++ )
+	{
+		// Already in the pool
+		if ( it->conflicts == conflicts && it->values == values ) return false;
+		if ( it->conflicts > worst->conflicts ) worst = it;
+	}
+
+	if ( states.size() < capacity )
+	{
+		states.push_back( EliteState() );
+		worst = states.end() - 1;
+	}
+	else if ( conflicts >= worst->conflicts )
+	{
+		return false;
+	}
+
+	// Reuses the storage of the replaced state
+	worst->values.assign( values.begin(), values.end() );
+	worst->conflicts = conflicts;
+
+	return true;
 }
 
 
-std::ostream& LsProblemManager::AnnealingConfiguration::configuration (std::ostream& out)
+bool ElitePool::sample (StateVector& values, MTRand_int32& random)
 {
-	out << "Algorithm used: Simulated Annealing" << std::endl;
-	// Print configuration parameters specific for the scheduler used
-	scheduler->configuration(out);
+	if ( states.empty() ) return false;
 
-	return out;
+	const StateVector& selected = states[ random( states.size() ) ].values;
+	values.assign( selected.begin(), selected.end() );
+
+	return true;
 }
 
-std::ostream& LsProblemManager::AnnealingConfiguration::statistics (std::ostream& out)
+
+unsigned long ElitePool::best (void)
 {
-	out << "Restarted: `" << restarts << "' times" << std::endl;
-	out << "In last iteration used: `" << steps << "' steps" << std::endl;
+	unsigned long bestConflicts = naxos::NsUPLUS_INF;
+	for ( std::vector<EliteState>::iterator it = states.begin() ; it != states.end() ; it++ )
+		if ( it->conflicts < bestConflicts ) bestConflicts = it->conflicts;
 
-	return out;
+	return bestConflicts;
+}
+
+
+bool ElitePool::sampleBetter (StateVector& values, MTRand_int32& random, unsigned long conflicts)
+{
+	unsigned long better = 0;
+	for ( std::vector<EliteState>::iterator it = states.begin() ; it != states.end() ; it++ )
+		better += ( it->conflicts < conflicts );
+	if ( better == 0 ) return false;
+
+	// The selected-th state beating `conflicts'
+	unsigned long selected = random( better );
+	for ( std::vector<EliteState>::iterator it = states.begin() ; ; it++ )
+	{
+		if ( it->conflicts >= conflicts ) continue;
+		if ( selected-- == 0 )
+		{
+			values.assign( it->values.begin(), it->values.end() );
+			return true;
+		}
+	}
+}
+
+
+
+void PermutationInitializer::assign (naxos::NsIntVarArray& variables)
+{
+	using namespace naxos;
+
+	NsIndex size = variables.size();
+	if ( size == 0 ) return;
+	assert_Ns( variables[0].size() >= size, "PermutationInitializer::assign: The domain has fewer values than the variables" );
+
+	const CompactModel& 	model = pm.model();
+	values.clear();
+	for ( unsigned long k = 0 ; k < model.domains[0].size ; k++ ) values.push_back( model.domainValue( 0, k ) );
+
+	// The first `size' values of a Fisher-Yates shuffle
+	for ( NsIndex i = 0 ; i < size ; i++ )
+	{
+		std::swap( values[i], values[ i + pm.random( values.size() - i ) ] );
+		assert_Ns( variables[i].contains( values[i] ), "PermutationInitializer::assign: A value is outside the domain of its variable" );
+		variables[i].lsSet( values[i] );
+	}
+}
+
+
+void GreedyInitializer::arrange (naxos::NsIndex size)
+{
+	using namespace naxos;
+
+	sequence.resize( size );
+
+	if ( order == DEGREE_ORDER )
+	{
+		naxos::assert_Ns( hasGraph(), "GreedyInitializer::arrange: DEGREE_ORDER needs a constraint graph" );
+
+		// Counting sort, highest degree first
+		NsIndex maxDegree = 0;
+		for ( NsIndex i = 0 ; i < size ; i++ ) if ( degree(i) > maxDegree ) maxDegree = degree(i);
+
+		std::vector<NsIndex> start( maxDegree + 2, 0 );
+		for ( NsIndex i = 0 ; i < size ; i++ ) start[ maxDegree - degree(i) + 1 ]++;
+		for ( NsIndex d = 1 ; d <= maxDegree + 1 ; d++ ) start[d] += start[d - 1];
+		for ( NsIndex i = 0 ; i < size ; i++ ) sequence[ start[ maxDegree - degree(i) ]++ ] = i;
+
+		return;
+	}
+
+	for ( NsIndex i = 0 ; i < size ; i++ ) sequence[i] = i;
+
+	// Fisher-Yates shuffle
+	if ( order == RANDOM_ORDER )
+		for ( NsIndex i = size ; i > 1 ; i-- ) std::swap( sequence[i - 1], sequence[ pm.random(i) ] );
+}
+
+
+void GreedyInitializer::assign (naxos::NsIntVarArray& variables)
+{
+	if ( groups != NULL || differentNeighbours ) 	assignCounting( variables );
+	else 						assignProbing( variables );
+}
+
+
+void GreedyInitializer::prepareCounts (naxos::NsIntVarArray& variables)
+{
+	using namespace naxos;
+
+	const CompactModel& 	model = pm.model();
+	NsIndex 		size = variables.size();
+	naxos::assert_Ns( !differentNeighbours || hasGraph(), "GreedyInitializer::prepareCounts: Different neighbours need a constraint graph" );
+
+	assigned.assign( size, false );
+	membershipOffsets.assign( size + 1, 0 );
+	memberships.clear();
+	groupMin.clear();
+	groupOffsets.assign( 1, 0 );
+	if ( groups != NULL )
+	{
+		// The memberships in compressed sparse row form, and the range of shifted values of every group
+		for ( DifferenceGroups::const_iterator g = groups->begin() ; g != groups->end() ; g++ )
+			for ( DifferenceGroup::const_iterator m = g->begin() ; m != g->end() ; m++ )
+			{
+				naxos::assert_Ns( m->first < size, "GreedyInitializer::prepareCounts: A difference group has a variable that isn't labeled" );
+				membershipOffsets[m->first + 1]++;
+			}
+		for ( NsIndex i = 0 ; i < size ; i++ ) membershipOffsets[i + 1] += membershipOffsets[i];
+		memberships.resize( membershipOffsets[size] );
+
+		std::vector<unsigned long> next( membershipOffsets.begin(), membershipOffsets.end() - 1 );
+		for ( DifferenceGroups::const_iterator g = groups->begin() ; g != groups->end() ; g++ )
+		{
+			NsInt low = NsPLUS_INF, high = NsMINUS_INF;
+			for ( DifferenceGroup::const_iterator m = g->begin() ; m != g->end() ; m++ )
+			{
+				memberships[ next[m->first]++ ] = std::make_pair( static_cast<NsIndex>(g - groups->begin()), m->second );
+				if ( model.domains[m->first].min + m->second < low ) low = model.domains[m->first].min + m->second;
+				if ( model.domains[m->first].max + m->second > high ) high = model.domains[m->first].max + m->second;
+			}
+			if ( g->empty() ) low = high = 0;
+			groupMin.push_back( low );
+			groupOffsets.push_back( groupOffsets.back() + (high - low + 1) );
+		}
+	}
+	groupCounts.assign( groupOffsets.back(), 0 );
+}
+
+
+unsigned long GreedyInitializer::countConflicts (naxos::NsIndex i, naxos::NsInt value, naxos::NsInt minValue)
+{
+	unsigned long conflicts = differentNeighbours ? neighbourCounts[value - minValue] : 0;
+	for ( unsigned long k = membershipOffsets[i] ; k < membershipOffsets[i + 1] ; k++ )
+	{
+		naxos::NsIndex g = memberships[k].first;
+		conflicts += groupCounts[ groupOffsets[g] + (value + memberships[k].second - groupMin[g]) ];
+	}
+
+	return conflicts;
+}
+
+
+void GreedyInitializer::assignCounting (naxos::NsIntVarArray& variables)
+{
+	using namespace naxos;
+
+	const CompactModel& 	model = pm.model();
+	prepareCounts( variables );
+	arrange( variables.size() );
+
+	for ( std::vector<NsIndex>::iterator it = sequence.begin() ; it != sequence.end() ; it++ )
+	{
+		NsIndex 	i = *it;
+		NsIntVar& 	variable = variables[i];
+		NsInt 		minValue = model.domains[i].min;
+		NsIndex 	size = model.domains[i].size;
+		bool 		wholeDomain = ( maxTries == 0 || maxTries >= size );
+
+		// The values of the assigned neighbours, gathered once for all the values tried
+		if ( differentNeighbours )
+		{
+			neighbourCounts.resize( model.domains[i].max - minValue + 1 );
+			for ( NsIndex k = 0, iDegree = degree(i) ; k < iDegree ; k++ )
+			{
+				NsIndex j = neighbour(i, k);
+				if ( assigned[j] && variables[j].lsValue() >= minValue && variables[j].lsValue() <= model.domains[i].max )
+					neighbourCounts[ variables[j].lsValue() - minValue ]++;
+			}
+		}
+
+		// The first value violating nothing, or else the one violating the fewest constraints
+		NsInt 		bestValue = variable.min();
+		unsigned long 	bestConflicts = NsUPLUS_INF;
+		for ( unsigned long tries = 0 ; tries < ( wholeDomain ? size : maxTries ) ; tries++ )
+		{
+			NsInt 		currentValue = wholeDomain ? model.domainValue( i, tries ) : pm.randomValue( variable );
+			unsigned long 	currentConflicts = countConflicts( i, currentValue, minValue );
+			if ( currentConflicts < bestConflicts )
+			{
+				bestConflicts = currentConflicts;
+				bestValue = currentValue;
+				if ( currentConflicts == 0 ) break;
+			}
+		}
+
+		variable.lsSet( bestValue );
+		assigned[i] = true;
+		for ( unsigned long k = membershipOffsets[i] ; k < membershipOffsets[i + 1] ; k++ )
+		{
+			NsIndex g = memberships[k].first;
+			groupCounts[ groupOffsets[g] + (bestValue + memberships[k].second - groupMin[g]) ]++;
+		}
+
+		// Cleared for the next variable
+		if ( differentNeighbours )
+			for ( NsIndex k = 0, iDegree = degree(i) ; k < iDegree ; k++ )
+			{
+				NsIndex j = neighbour(i, k);
+				if ( assigned[j] && variables[j].lsValue() >= minValue && variables[j].lsValue() <= model.domains[i].max )
+					neighbourCounts[ variables[j].lsValue() - minValue ] = 0;
+			}
+	}
+}
+
+
+void GreedyInitializer::assignProbing (naxos::NsIntVarArray& variables)
+{
+	using namespace naxos;
+
+	const CompactModel& 	model = pm.model();
+	arrange( variables.size() );
+
+	for ( std::vector<NsIndex>::iterator it = sequence.begin() ; it != sequence.end() ; it++ )
+	{
+		NsIntVar& 	variable = variables[*it];
+		NsIndex 	size = model.domains[*it].size;
+		NsInt 		bestValue = variable.min();
+		NsUInt 		bestConflicts = NsUPLUS_INF;
+		bool 		wholeDomain = ( maxTries == 0 || maxTries >= size );
+
+		// Only the constraints with assigned variables may be violated;
+		// The conflicts of the variable are those with the variables already assigned
+		NsInt currentValue = wholeDomain ? variable.min() : pm.randomValue( variable );
+		for ( unsigned long tries = 0 ; ; )
+		{
+			variable.lsSet( currentValue );
+			NsUInt currentConflicts = variable.lsViolatedConstraints().size();
+			// Keep the first value violating nothing
+			if ( currentConflicts == 0 ) break;
+			variable.lsUnset();
+
+			if ( currentConflicts < bestConflicts )
+			{
+				bestConflicts = currentConflicts;
+				bestValue = currentValue;
+			}
+
+			if ( ++tries == ( wholeDomain ? size : maxTries ) ) { variable.lsSet( bestValue ); break; }
+			currentValue = wholeDomain ? model.domainValue( *it, tries ) : pm.randomValue( variable );
+		}
+	}
+}
+
+
+void DsaturInitializer::assign (naxos::NsIntVarArray& variables)
+{
+	using namespace naxos;
+
+	const CompactModel& 	model = pm.model();
+	NsIndex size = variables.size();
+	naxos::assert_Ns( hasGraph(), "DsaturInitializer::assign: No constraint graph given" );
+	naxos::assert_Ns( graph == NULL || graph->size() == size, "DsaturInitializer::assign: The constraint graph doesn't match the variables" );
+	if ( size == 0 ) return;
+
+	// Every variable has room for as many distinct values around it as it has neighbours
+	seenOffsets.resize( size + 1 );
+	seenOffsets[0] = 0;
+	for ( NsIndex i = 0 ; i < size ; i++ ) seenOffsets[i + 1] = seenOffsets[i] + degree(i);
+	seen.resize( seenOffsets[size] );
+	saturation.assign( size, 0 );
+	assigned.assign( size, false );
+
+	// Ordered by saturation, then degree; the last element is the next to assign
+	typedef std::pair<std::pair<NsIndex, NsIndex>, NsIndex> Priority;
+	std::set<Priority> 	queue;
+	for ( NsIndex i = 0 ; i < size ; i++ ) queue.insert( std::make_pair(std::make_pair(0UL, degree(i)), i) );
+
+	while ( !queue.empty() )
+	{
+		NsIndex 	i = (--queue.end())->second;
+		NsIntVar& 	variable = variables[i];
+		queue.erase( --queue.end() );
+
+		// The smallest value unused by the neighbours, or else the least used; Merging the sorted values around
+		// with the ascending domain, an unused one is met within the first `saturation[i] + 1' positions
+		around.assign( seen.begin() + seenOffsets[i], seen.begin() + seenOffsets[i] + saturation[i] );
+		std::sort( around.begin(), around.end() );
+		std::vector<std::pair<int, NsIndex> >::iterator 	next = around.begin();
+		NsInt 	bestValue = variable.min();
+		NsIndex bestCount = NsUPLUS_INF;
+		for ( unsigned long k = 0 ; k < model.domains[i].size ; k++ )
+		{
+			int 	value = model.domainValue( i, k );
+			while ( next != around.end() && next->first < value ) next++;
+			NsIndex count = ( next != around.end() && next->first == value ) ? next->second : 0;
+			if ( count < bestCount )
+			{
+				bestCount = count;
+				bestValue = value;
+				if ( count == 0 ) break;
+			}
+		}
+
+		variable.lsSet( bestValue );
+		assigned[i] = true;
+
+		// The unassigned neighbours meeting the value for the first time become more saturated
+		for ( NsIndex k = 0, iDegree = degree(i) ; k < iDegree ; k++ )
+		{
+			NsIndex j = neighbour(i, k);
+			if ( assigned[j] ) continue;
+
+			std::vector<std::pair<int, NsIndex> >::iterator 	first = seen.begin() + seenOffsets[j];
+			std::vector<std::pair<int, NsIndex> >::iterator 	last = first + saturation[j];
+			std::vector<std::pair<int, NsIndex> >::iterator 	it = first;
+			while ( it != last && it->first != bestValue ) it++;
+			if ( it != last ) { it->second++; continue; }
+
+			*last = std::make_pair( static_cast<int>(bestValue), 1UL );
+			queue.erase( std::make_pair(std::make_pair(saturation[j], degree(j)), j) );
+			saturation[j]++;
+			queue.insert( std::make_pair(std::make_pair(saturation[j], degree(j)), j) );
+		}
+	}
+}
+
+
+
+////////////////////////////////////// Solution Writers //////////////////////////////////////
+
+void TextSolutionWriter::operator() (const int* values, naxos::NsIndex size)
+{
+	// A value takes at most 11 characters, and a separator or the newline one more
+	if ( buffer.size() < size * 12 + 1 ) buffer.resize( size * 12 + 1 );
+
+	char* 	p = &buffer[0];
+	for ( naxos::NsIndex i = 0 ; i < size ; i++ )
+	{
+		if ( i != 0 ) *p++ = ' ';
+		p = format( p, values[i] );
+	}
+	*p++ = '\n';
+
+	out.write( &buffer[0], p - &buffer[0] );
+}
+
+
+void BinarySolutionWriter::operator() (const int* values, naxos::NsIndex size)
+{
+	if ( size == 0 ) return;
+	if ( buffer.size() < size * 4 ) buffer.resize( size * 4 );
+
+	encode( &buffer[0], values, size );
+	out.write( reinterpret_cast<const char*>(&buffer[0]), size * 4 );
+}
+
+
+#ifdef LOCAL_S_MAPPED_WRITER
+
+MappedSolutionWriter::MappedSolutionWriter (const std::string& path) : mapping(NULL), capacity(0), written(0)
+{
+	file = open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	naxos::assert_Ns( file != -1, "MappedSolutionWriter::MappedSolutionWriter: Cannot open the output file" );
+}
+
+
+MappedSolutionWriter::~MappedSolutionWriter (void)
+{
+	if ( mapping != NULL ) munmap( mapping, capacity );
+	if ( ftruncate( file, written ) != 0 ) std::cerr << "MappedSolutionWriter: Cannot truncate the output file" << std::endl;
+	close( file );
+}
+
+
+void MappedSolutionWriter::grow (unsigned long needed)
+{
+	unsigned long newCapacity = ( capacity == 0 ) ? 1UL << 20 : capacity;
+	while ( newCapacity < needed ) newCapacity *= 2;
+
+	if ( mapping != NULL ) munmap( mapping, capacity );
+	mapping = NULL;
+	naxos::assert_Ns( ftruncate( file, newCapacity ) == 0, "MappedSolutionWriter::grow: Cannot extend the output file" );
+
+	void* address = mmap( NULL, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0 );
+	naxos::assert_Ns( address != MAP_FAILED, "MappedSolutionWriter::grow: Cannot map the output file" );
+	mapping = static_cast<unsigned char*>( address );
+	capacity = newCapacity;
+}
+
+
+void MappedSolutionWriter::operator() (const int* values, naxos::NsIndex size)
+{
+	if ( written + size * 4 > capacity ) grow( written + size * 4 );
+
+	BinarySolutionWriter::encode( mapping + written, values, size );
+	written += size * 4;
+}
+
+#endif
+
+
+
+////////////////////////////////////// MappedFile //////////////////////////////////////
+
+MappedFile::MappedFile (const std::string& path) : bytes(NULL), length(0), mapping(NULL)
+{
+#ifdef LOCAL_S_MAPPED_WRITER
+	int 	file = open( path.c_str(), O_RDONLY );
+	naxos::assert_Ns( file != -1, "MappedFile::MappedFile: Cannot open the file" );
+	struct stat 	status;
+	if ( fstat( file, &status ) != 0 )
+	{
+		close( file );
+		naxos::assert_Ns( false, "MappedFile::MappedFile: Cannot read the size of the file" );
+	}
+	length = status.st_size;
+	// An empty file can't be mapped
+	if ( length != 0 )
+	{
+		void* 	address = mmap( NULL, length, PROT_READ, MAP_PRIVATE, file, 0 );
+		close( file );
+		naxos::assert_Ns( address != MAP_FAILED, "MappedFile::MappedFile: Cannot map the file" );
+		madvise( address, length, MADV_SEQUENTIAL );
+		mapping = address;
+		bytes = static_cast<const char*>( address );
+		return;
+	}
+	close( file );
+#else
+	std::ifstream 	in( path.c_str(), std::ios::binary );
+	naxos::assert_Ns( in.good(), "MappedFile::MappedFile: Cannot open the file" );
+	buffer.assign( (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>() );
+	length = buffer.size();
+#endif
+	bytes = buffer.data();
+}
+
+
+MappedFile::~MappedFile (void)
+{
+#ifdef LOCAL_S_MAPPED_WRITER
+	if ( mapping != NULL ) munmap( mapping, length );
+#endif
+}
+
+
+
+////////////////////////////////////// TraceRecorder //////////////////////////////////////
+
+// Seconds on a monotonic wall clock, from an arbitrary origin; Processor time where there is none
+static double wallSeconds (void)
+{
+#if defined(LOCAL_S_MAPPED_WRITER) && defined(CLOCK_MONOTONIC)
+	struct timespec 	now;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+	return static_cast<double>( clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+
+TraceRecorder::TraceRecorder (unsigned long capacity, double growth_) : samples(capacity), growth(growth_)
+{
+	naxos::assert_Ns( capacity > 0, "TraceRecorder::TraceRecorder: The capacity must be positive" );
+	naxos::assert_Ns( growth > 1.0, "TraceRecorder::TraceRecorder: The growth must be greater than one" );
+	clear();
+}
+
+
+void TraceRecorder::clear (void)
+{
+	head = 0;
+	count = 0;
+	steps = 0;
+	nextSample = 0;
+	restarts = 0;
+	started = wallSeconds();
+}
+
+
+void TraceRecorder::record (unsigned long conflicts, double temperature)
+{
+	// The oldest sample is overwritten once the ring is full
+	Sample& 	sample = samples[ (head + count) % samples.size() ];
+	if ( count == samples.size() ) 	head = (head + 1) % samples.size();
+	else 				count++;
+
+	sample.step = steps;
+	sample.time = wallSeconds() - started;
+	sample.conflicts = conflicts;
+	sample.temperature = temperature;
+	sample.restarts = restarts;
+	restarts = 0;
+
+	unsigned long 	next = static_cast<unsigned long>( steps * growth );
+	nextSample = ( next > steps ) ? next : steps + 1;
+}
+
+
+std::ostream& TraceRecorder::writeCsv (std::ostream& out) const
+{
+	out << "step,time,conflicts,temperature,restarts\n";
+	for ( unsigned long i = 0 ; i < count ; i++ )
+	{
+		const Sample& 	sample = (*this)[i];
+		out << sample.step << "," << sample.time << "," << sample.conflicts << "," << sample.temperature << "," << sample.restarts << "\n";
+	}
+
+	return out;
+}
+
+
+// Eight bytes little endian
+static void encode64 (unsigned char* p, unsigned long long value)
+{
+	for ( int b = 0 ; b < 8 ; b++, value >>= 8 ) p[b] = static_cast<unsigned char>( value );
+}
+
+static unsigned long long doubleBits (double value)
+{
+	unsigned long long 	bits;
+	std::memcpy( &bits, &value, sizeof(bits) );
+	return bits;
+}
+
+
+std::ostream& TraceRecorder::writeBinary (std::ostream& out) const
+{
+	std::vector<unsigned char> 	buffer( 16 + count * 40 );
+	std::memcpy( &buffer[0], "LSTRACE1", 8 );
+	encode64( &buffer[8], count );
+	for ( unsigned long i = 0 ; i < count ; i++ )
+	{
+		const Sample& 	sample = (*this)[i];
+		unsigned char* 	p = &buffer[16 + i * 40];
+		encode64( p, sample.step );
+		encode64( p + 8, doubleBits( sample.time ) );
+		encode64( p + 16, sample.conflicts );
+		encode64( p + 24, doubleBits( sample.temperature ) );
+		encode64( p + 32, sample.restarts );
+	}
+	out.write( reinterpret_cast<const char*>(&buffer[0]), buffer.size() );
+
+	return out;
+}
+
+
+
+////////////////////////////////////// Canonicalizers //////////////////////////////////////
+
+void DihedralCanonicalizer::canonicalize (const StateVector& values, StateVector& canonical)
+{
+	int 	N = static_cast<int>( values.size() );
+	for ( int i = 0 ; i < N ; i++ )
+		naxos::assert_Ns( 0 <= values[i] && values[i] < N, "DihedralCanonicalizer::canonicalize: The values must be columns in [0, N)" );
+
+	canonical = values;
+	candidate.resize( N );
+
+	// Seven symmetries besides the identity; a queen on (i, values[i]) moves to (row, column)
+	for ( int symmetry = 1 ; symmetry < 8 ; symmetry++ )
+	{
+		for ( int i = 0 ; i < N ; i++ )
+		{
+			int 	j = values[i];
+			switch ( symmetry )
+			{
+				case 1: candidate[j] = N - 1 - i; 		break; 	// Rotation by 90 degrees
+				case 2: candidate[N - 1 - i] = N - 1 - j; 	break; 	// Rotation by 180 degrees
+				case 3: candidate[N - 1 - j] = i; 		break; 	// Rotation by 270 degrees
+				case 4: candidate[i] = N - 1 - j; 		break; 	// Reflection of the columns
+				case 5: candidate[N - 1 - i] = j; 		break; 	// Reflection of the rows
+				case 6: candidate[j] = i; 			break; 	// Reflection on the main diagonal
+				case 7: candidate[N - 1 - j] = N - 1 - i; 	break; 	// Reflection on the anti-diagonal
+			}
+		}
+
+		if ( std::lexicographical_compare( candidate.begin(), candidate.end(), canonical.begin(), canonical.end() ) )
+			canonical.swap( candidate );
+	}
+}
+
+
+void ColorCanonicalizer::canonicalize (const StateVector& values, StateVector& canonical)
+{
+	canonical.resize( values.size() );
+	relabel.clear();
+
+	int 	nextColor = firstColor;
+	for ( naxos::NsIndex i = 0, size = values.size() ; i < size ; i++ )
+	{
+		naxos::assert_Ns( values[i] >= firstColor, "ColorCanonicalizer::canonicalize: A color is less than the first color" );
+		unsigned long 	color = values[i] - firstColor;
+		if ( color >= relabel.size() ) relabel.resize( color + 1, -1 );
+		if ( relabel[color] == -1 ) relabel[color] = nextColor++;
+		canonical[i] = relabel[color];
+	}
+}
+
+
+
+////////////////////////////////////// CompactModel //////////////////////////////////////
+
+void CompactModel::build (naxos::NsIntVarArray& variables, const ConstraintGraph* graph)
+{
+	using namespace naxos;
+
+	NsIndex size = variables.size();
+	values.assign( size, 0 );
+	domains.resize( size );
+	domainValues.clear();
+
+	for ( NsIndex i = 0 ; i < size ; i++ )
+	{
+		NsIntVar& 	variable = variables[i];
+		Domain& 	domain = domains[i];
+		domain.min = static_cast<int>( variable.min() );
+		domain.max = static_cast<int>( variable.max() );
+		domain.size = static_cast<unsigned int>( variable.size() );
+		domain.offset = INTERVAL;
+		if ( variable.max() - variable.min() + 1 == static_cast<NsInt>(variable.size()) ) continue;
+
+		// Share the values of the previous variable if they are the same
+		if ( i > 0 && domains[i - 1].offset != INTERVAL && domains[i - 1].min == domain.min
+				&& domains[i - 1].max == domain.max && domains[i - 1].size == domain.size )
+		{
+			const int* 	previous = &domainValues[ domains[i - 1].offset ];
+			NsInt 		value = variable.min();
+			unsigned int 	k;
+			for ( k = 0 ; k < domain.size && previous[k] == value ; k++, value = variable.next(value) ) ;
+			if ( k == domain.size )
+			{
+				domain.offset = domains[i - 1].offset;
+				continue;
+			}
+		}
+
+		domain.offset = static_cast<unsigned int>( domainValues.size() );
+		for ( NsInt value = variable.min() ; value <= variable.max() ; value = variable.next(value) )
+			domainValues.push_back( static_cast<int>(value) );
+	}
+
+	neighbourOffsets.clear();
+	neighbours.clear();
+	if ( graph == NULL ) return;
+
+	assert_Ns( graph->size() == size, "CompactModel::build: The constraint graph doesn't match the variables" );
+
+	// Counted first, so that the arrays are allocated exactly once
+	NsIndex edges = 0;
+	for ( NsIndex i = 0 ; i < size ; i++ ) edges += (*graph)[i].size();
+	neighbourOffsets.reserve( size + 1 );
+	neighbours.reserve( edges );
+
+	neighbourOffsets.push_back( 0 );
+	for ( NsIndex i = 0 ; i < size ; i++ )
+	{
+		neighbours.insert( neighbours.end(), (*graph)[i].begin(), (*graph)[i].end() );
+		neighbourOffsets.push_back( static_cast<unsigned int>(neighbours.size()) );
+	}
+}
+
+
+std::ostream& CompactModel::memoryReport (std::ostream& out) const
+{
+	unsigned long 	valueBytes = values.capacity() * sizeof(int);
+	unsigned long 	domainBytes = domains.capacity() * sizeof(Domain) + domainValues.capacity() * sizeof(int);
+	unsigned long 	graphBytes = ( neighbourOffsets.capacity() + neighbours.capacity() ) * sizeof(unsigned int);
+
+	out << "Values: `" << valueBytes << "' bytes" << std::endl;
+	out << "Domains: `" << domainBytes << "' bytes (`" << domainValues.size() << "' values of domains with holes)" << std::endl;
+	out << "Constraint graph: `" << graphBytes << "' bytes (`" << neighbours.size() << "' neighbours)" << std::endl;
+	out << "Compact model total: `" << valueBytes + domainBytes + graphBytes << "' bytes" << std::endl;
+
+	return out;
+}
+
+
+
+////////////////////////////////////// ConstraintIndex //////////////////////////////////////
+
+unsigned long ConstraintIndex::insert (unsigned long bucket, const std::vector<naxos::NsIndex>& indices, unsigned long key)
+{
+	// First sight
+	unsigned long 	newId = size();
+	members.insert( members.end(), indices.begin(), indices.end() );
+	offsets.push_back( members.size() );
+	hashes.push_back( key );
+	lastWalk.push_back( 0 );
+	buckets[bucket] = newId + 1;
+	if ( 2 * size() > buckets.size() ) grow();
+
+	return newId;
+}
+
+
+void ConstraintIndex::key (unsigned long id, std::vector<naxos::NsIndex>& indices) const
+{
+	indices.assign( members.begin() + offsets[id], members.begin() + offsets[id + 1] );
+}
+
+
+void ConstraintIndex::grow (void)
+{
+	// Every id is put back in a table twice the size
+	buckets.assign( 2 * buckets.size(), 0 );
+	unsigned long 	mask = buckets.size() - 1;
+	for ( unsigned long id = 0 ; id < size() ; id++ )
+	{
+		unsigned long 	bucket = hashes[id] & mask;
+		while ( buckets[bucket] != 0 ) bucket = (bucket + 1) & mask;
+		buckets[bucket] = id + 1;
+	}
+}
+
+
+unsigned long ConstraintIndex::bytes (void) const
+{
+	return members.capacity() * sizeof(naxos::NsIndex) + ( offsets.capacity() + hashes.capacity() + buckets.capacity() + lastWalk.capacity() ) * sizeof(unsigned long);
+}
+
+
+
+////////////////////////////////////// Checkpoints //////////////////////////////////////
+
+// Checkpoint files are written in the byte order of the machine
+namespace
+{
+	const char 		checkpointMagic[4] = {'L', 'S', 'C', 'P'};
+	const unsigned int 	checkpointVersion = 4;
+
+	template <class TemplType>
+	void writeBinary (std::ostream& out, TemplType value)
+	{
+		out.write( reinterpret_cast<const char*>(&value), sizeof(value) );
+	}
+
+	template <class TemplType>
+	TemplType readBinary (std::istream& in)
+	{
+		TemplType value;
+		in.read( reinterpret_cast<char*>(&value), sizeof(value) );
+		naxos::assert_Ns( !in.fail(), "LsProblemManager::restoreCheckpoint: Truncated checkpoint" );
+		return value;
+	}
+
+	void writeState (std::ostream& out, const StateVector& state)
+	{
+		if ( !state.empty() ) out.write( reinterpret_cast<const char*>(&state[0]), state.size() * sizeof(state[0]) );
+	}
+
+	void readState (std::istream& in, StateVector& state, unsigned long size)
+	{
+		state.resize( size );
+		if ( size != 0 ) in.read( reinterpret_cast<char*>(&state[0]), size * sizeof(state[0]) );
+		naxos::assert_Ns( !in.fail(), "LsProblemManager::restoreCheckpoint: Truncated checkpoint" );
+	}
+}
+
+
+void LsProblemManager::checkpointEvery (const std::string& path, unsigned long steps, double seconds)
+{
+	checkpointPath 		= path;
+	// With a time interval only, poll the clock every 1024 steps
+	checkpointSteps 	= ( steps == 0 && seconds > 0.0 ) ? 1024 : steps;
+	checkpointSeconds 	= seconds;
+	stepsSinceCheckpoint 	= 0;
+	checkpointTimer.start();
+}
+
+
+void LsProblemManager::materializeBest (void)
+{
+	captureState( bestState );
+	// Undo the changes since the best state, latest first
+	for ( std::vector<std::pair<naxos::NsIndex, int> >::reverse_iterator it = bestJournal.rbegin() ; it != bestJournal.rend() ; it++ )
+		bestState[it->first] = it->second;
+
+	bestJournal.clear();
+	bestJournalValid = false;
+}
+
+
+void LsProblemManager::materializeIterated (void)
+{
+	captureState( iteratedState );
+	for ( std::vector<std::pair<naxos::NsIndex, int> >::reverse_iterator it = iteratedJournal.rbegin() ; it != iteratedJournal.rend() ; it++ )
+		iteratedState[it->first] = it->second;
+
+	iteratedJournal.clear();
+	iteratedJournalValid = false;
+}
+
+
+unsigned long LsProblemManager::bestAssignment (StateVector& state)
+{
+	if ( bestJournalValid )
+	{
+		captureState( state );
+		for ( std::vector<std::pair<naxos::NsIndex, int> >::reverse_iterator it = bestJournal.rbegin() ; it != bestJournal.rend() ; it++ )
+			state[it->first] = it->second;
+	}
+	else
+	{
+		state.assign( bestState.begin(), bestState.end() );
+	}
+
+	return bestConflicts;
+}
+
+
+void LsProblemManager::saveCheckpoint (const std::string& path)
+{
+	naxos::assert_Ns( varArray != NULL , "LsProblemManager::saveCheckpoint: You must first call `LsProblemManager::label'" );
+	// The states of an elite pool belong to the application, which may share the pool
+	naxos::assert_Ns( conf->algorithm() != HILL || static_cast<HillConfiguration*>(conf)->elitePool == NULL,
+			"LsProblemManager::saveCheckpoint: The elite pool isn't saved; Checkpoints can't be used with it" );
+
+	// Written aside and renamed, so that a run killed while writing leaves the previous checkpoint intact
+	std::string temporaryPath = path + ".tmp";
+	std::ofstream out( temporaryPath.c_str(), std::ios::binary | std::ios::trunc );
+	naxos::assert_Ns( out.good(), "LsProblemManager::saveCheckpoint: Cannot open the checkpoint file" );
+
+	out.write( checkpointMagic, sizeof(checkpointMagic) );
+	writeBinary<unsigned int>( out, checkpointVersion );
+	writeBinary<unsigned int>( out, conf->algorithm() );
+	writeBinary<unsigned long>( out, varArray->size() );
+
+	captureState( stateBuffer );
+	writeState( out, stateBuffer );
+
+	StateVector best;
+	unsigned long bestConflicts_ = bestAssignment( best );
+	writeBinary<unsigned long>( out, bestConflicts_ );
+	writeBinary<unsigned long>( out, best.size() );
+	writeState( out, best );
+
+	writeBinary<unsigned long>( out, tabuAssignments.size() );
+	for ( ActiveWindow<Assignment>::iterator it = tabuAssignments.begin() ; it != tabuAssignments.end() ; it++ )
+	{
+		writeBinary<unsigned long>( out, it->first->lsIndex() );
+		writeBinary<int>( out, it->second );
+	}
+
+	writeBinary<unsigned long>( out, checkpointData.schedulerStep );
+	writeBinary<unsigned long>( out, checkpointData.stableStep );
+
+	std::vector<unsigned long> counters;
+	conf->saveCounters( counters );
+	writeBinary<unsigned long>( out, counters.size() );
+	for ( std::vector<unsigned long>::iterator it = counters.begin() ; it != counters.end() ; it++ ) writeBinary<unsigned long>( out, *it );
+
+	// Constraint weights, by the variables of their constraints as the ids depend on the order they were met in
+	std::vector<naxos::NsIndex> 	indices;
+	unsigned long 			weights = 0, weighted = ( weightIncrement == 0 ) ? 0 : constraintWeights.size();
+	for ( unsigned long id = 0 ; id < weighted ; id++ )
+		if ( constraintWeights[id] != 1 ) weights++;
+	writeBinary<unsigned long>( out, weights );
+	for ( unsigned long id = 0 ; id < weighted ; id++ )
+	{
+		if ( constraintWeights[id] == 1 ) continue;
+		constraintIndex.key( id, indices );
+		writeBinary<unsigned long>( out, indices.size() );
+		for ( std::vector<naxos::NsIndex>::iterator it = indices.begin() ; it != indices.end() ; it++ ) writeBinary<unsigned long>( out, *it );
+		writeBinary<unsigned long>( out, constraintWeights[id] );
+	}
+
+	// Guided Local Search penalties
+	unsigned long 	features = 0;
+	for ( std::vector<naxos::NsIndex>::iterator it = penalizedVariables.begin() ; it != penalizedVariables.end() ; it++ )
+		features += penalties[*it].size();
+	writeBinary<unsigned long>( out, penaltyLambda == 0 ? 0 : features );
+	if ( penaltyLambda != 0 )
+		for ( std::vector<naxos::NsIndex>::iterator it = penalizedVariables.begin() ; it != penalizedVariables.end() ; it++ )
+			for ( FeaturePenalties::iterator feature = penalties[*it].begin() ; feature != penalties[*it].end() ; feature++ )
+			{
+				writeBinary<unsigned long>( out, *it );
+				writeBinary<int>( out, feature->first );
+				writeBinary<unsigned long>( out, feature->second );
+			}
+
+	// Iterated Local Search; the accepted optimum is the current state with the journal undone
+	writeBinary<unsigned long>( out, iteratedConflicts );
+	writeBinary<unsigned long>( out, iteratedMoves );
+	StateVector 	accepted;
+	if ( iteratedConflicts != naxos::NsUPLUS_INF )
+	{
+		if ( iteratedJournalValid )
+		{
+			captureState( accepted );
+			for ( std::vector<std::pair<naxos::NsIndex, int> >::reverse_iterator it = iteratedJournal.rbegin() ; it != iteratedJournal.rend() ; it++ )
+				accepted[it->first] = it->second;
+		}
+		else
+		{
+			accepted = iteratedState;
+		}
+	}
+	writeBinary<unsigned long>( out, accepted.size() );
+	writeState( out, accepted );
+	writeBinary<unsigned long>( out, iteratedOptima.size() );
+	for ( ActiveWindow<StateHash>::iterator it = iteratedOptima.begin() ; it != iteratedOptima.end() ; it++ ) writeBinary<StateHash>( out, *it );
+
+	// The restart policy's limit on the iteration in progress
+	RestartPolicy* 	restartPolicy = ( conf->algorithm() == HILL ) ? static_cast<HillConfiguration*>(conf)->restartPolicy : NULL;
+	writeBinary<unsigned char>( out, restartPolicy != NULL );
+	writeBinary<unsigned long>( out, restartPolicy != NULL ? (*restartPolicy)[ static_cast<HillConfiguration*>(conf)->restarts ] : 0 );
+
+	// Late Acceptance's history, whose position is that of the step count
+	unsigned long 	historyLength = ( conf->algorithm() == LATE_ACCEPTANCE ) ? lateHistory.size() : 0;
+	writeBinary<unsigned long>( out, historyLength );
+	for ( unsigned long i = 0 ; i < historyLength ; i++ ) writeBinary<unsigned long>( out, lateHistory[i] );
+
+	unsigned long 	randomState[MTRand_int32::stateSize];
+	int 		randomPosition;
+	random.getState( randomState, randomPosition );
+	writeBinary<int>( out, randomPosition );
+	for ( int i = 0 ; i < MTRand_int32::stateSize ; i++ ) writeBinary<unsigned int>( out, randomState[i] );
+
+	out.close();
+	naxos::assert_Ns( !out.fail(), "LsProblemManager::saveCheckpoint: Cannot write the checkpoint file" );
+	naxos::assert_Ns( std::rename( temporaryPath.c_str(), path.c_str() ) == 0, "LsProblemManager::saveCheckpoint: Cannot replace the checkpoint file" );
+}
+
+
+void LsProblemManager::restoreCheckpoint (const std::string& path)
+{
+	naxos::assert_Ns( varArray != NULL , "LsProblemManager::restoreCheckpoint: You must first call `LsProblemManager::label'" );
+
+	std::ifstream in( path.c_str(), std::ios::binary );
+	naxos::assert_Ns( in.good(), "LsProblemManager::restoreCheckpoint: Cannot open the checkpoint file" );
+
+	char magic[sizeof(checkpointMagic)];
+	in.read( magic, sizeof(magic) );
+	naxos::assert_Ns( !in.fail() && std::equal( magic, magic + sizeof(magic), checkpointMagic ), "LsProblemManager::restoreCheckpoint: Not a checkpoint file" );
+	naxos::assert_Ns( readBinary<unsigned int>( in ) == checkpointVersion, "LsProblemManager::restoreCheckpoint: Unsupported checkpoint version" );
+
+	checkpointData.algorithm = readBinary<unsigned int>( in );
+	naxos::assert_Ns( checkpointData.algorithm == static_cast<unsigned int>(conf->algorithm()), "LsProblemManager::restoreCheckpoint: The checkpoint is of another algorithm" );
+	unsigned long size = readBinary<unsigned long>( in );
+	naxos::assert_Ns( size == varArray->size(), "LsProblemManager::restoreCheckpoint: The checkpoint is of another model" );
+
+	readState( in, checkpointData.values, size );
+
+	bestConflicts = readBinary<unsigned long>( in );
+	readState( in, bestState, readBinary<unsigned long>( in ) );
+	bestJournal.clear();
+	bestJournalValid = false;
+
+	checkpointData.tabu.resize( readBinary<unsigned long>( in ) );
+	for ( std::vector<std::pair<naxos::NsIndex, int> >::iterator it = checkpointData.tabu.begin() ; it != checkpointData.tabu.end() ; it++ )
+	{
+		it->first = readBinary<unsigned long>( in );
+		it->second = readBinary<int>( in );
+		naxos::assert_Ns( it->first < size, "LsProblemManager::restoreCheckpoint: Corrupt tabu list" );
+	}
+
+	checkpointData.schedulerStep = readBinary<unsigned long>( in );
+	checkpointData.stableStep = readBinary<unsigned long>( in );
+
+	checkpointData.counters.resize( readBinary<unsigned long>( in ) );
+	for ( std::vector<unsigned long>::iterator it = checkpointData.counters.begin() ; it != checkpointData.counters.end() ; it++ )
+		*it = readBinary<unsigned long>( in );
+
+	checkpointData.weights.resize( readBinary<unsigned long>( in ) );
+	for ( unsigned long k = 0 ; k < checkpointData.weights.size() ; k++ )
+	{
+		std::vector<naxos::NsIndex>& 	indices = checkpointData.weights[k].first;
+		indices.resize( readBinary<unsigned long>( in ) );
+		for ( std::vector<naxos::NsIndex>::iterator it = indices.begin() ; it != indices.end() ; it++ )
+		{
+			*it = readBinary<unsigned long>( in );
+			naxos::assert_Ns( *it < size, "LsProblemManager::restoreCheckpoint: Corrupt constraint weights" );
+		}
+		checkpointData.weights[k].second = readBinary<unsigned long>( in );
+	}
+
+	checkpointData.penalties.resize( readBinary<unsigned long>( in ) );
+	for ( unsigned long k = 0 ; k < checkpointData.penalties.size() ; k++ )
+	{
+		checkpointData.penalties[k].first.first = readBinary<unsigned long>( in );
+		checkpointData.penalties[k].first.second = readBinary<int>( in );
+		checkpointData.penalties[k].second = readBinary<unsigned long>( in );
+		naxos::assert_Ns( checkpointData.penalties[k].first.first < size, "LsProblemManager::restoreCheckpoint: Corrupt penalties" );
+	}
+
+	checkpointData.iteratedConflicts = readBinary<unsigned long>( in );
+	checkpointData.iteratedMoves = readBinary<unsigned long>( in );
+	readState( in, checkpointData.iteratedState, readBinary<unsigned long>( in ) );
+	naxos::assert_Ns( checkpointData.iteratedState.size() == ( checkpointData.iteratedConflicts == naxos::NsUPLUS_INF ? 0 : size ),
+			"LsProblemManager::restoreCheckpoint: Corrupt Iterated Local Search state" );
+	checkpointData.iteratedOptima.resize( readBinary<unsigned long>( in ) );
+	for ( std::vector<StateHash>::iterator it = checkpointData.iteratedOptima.begin() ; it != checkpointData.iteratedOptima.end() ; it++ )
+		*it = readBinary<StateHash>( in );
+
+	checkpointData.restartPolicy = ( readBinary<unsigned char>( in ) != 0 );
+	checkpointData.restartLimit = readBinary<unsigned long>( in );
+
+	checkpointData.lateHistory.resize( readBinary<unsigned long>( in ) );
+	for ( std::vector<unsigned long>::iterator it = checkpointData.lateHistory.begin() ; it != checkpointData.lateHistory.end() ; it++ )
+		*it = readBinary<unsigned long>( in );
+	naxos::assert_Ns( checkpointData.algorithm == LATE_ACCEPTANCE || checkpointData.lateHistory.empty(),
+			"LsProblemManager::restoreCheckpoint: Corrupt Late Acceptance history" );
+
+	unsigned long randomState[MTRand_int32::stateSize];
+	int randomPosition = readBinary<int>( in );
+	for ( int i = 0 ; i < MTRand_int32::stateSize ; i++ ) randomState[i] = readBinary<unsigned int>( in );
+	random.setState( randomState, randomPosition );
+
+	resumePending = true;
+}
+
+
+void LsProblemManager::resumeLearning (void)
+{
+	naxos::assert_Ns( checkpointData.weights.empty() || weightIncrement != 0, "LsProblemManager::resumeLearning: The checkpoint is of Constraint Weighting" );
+	std::vector<std::pair<std::vector<naxos::NsIndex>, unsigned long> >::iterator 	weight;
+	for ( weight = checkpointData.weights.begin() ; weight != checkpointData.weights.end() ; weight++ )
+	{
+		unsigned long 	id = constraintIndex.id( weight->first );
+		if ( id >= constraintWeights.size() ) constraintWeights.resize( id + 1, 1 );
+		constraintWeights[id] = weight->second;
+	}
+
+	naxos::assert_Ns( checkpointData.penalties.empty() || penaltyLambda != 0, "LsProblemManager::resumeLearning: The checkpoint is of Guided Local Search" );
+	std::vector<std::pair<std::pair<naxos::NsIndex, int>, unsigned long> >::iterator 	feature;
+	for ( feature = checkpointData.penalties.begin() ; feature != checkpointData.penalties.end() ; feature++ )
+	{
+		FeaturePenalties& 	features = penalties[ feature->first.first ];
+		if ( features.empty() ) penalizedVariables.push_back( feature->first.first );
+		features.push_back( std::make_pair(feature->first.second, feature->second) );
+	}
+}
+
+
+
+////////////////////////////////////// Various Statistics //////////////////////////////////////
+
+
+std::ostream& LsProblemManager::configuration (std::ostream& out)
+{
+	out << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "---------------------Configuration--------------------" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "Random generator running with seed: `" << seed << "'";
+	if ( stream != NO_STREAM ) out << ", stream `" << stream << "'";
+	out << std::endl;
+	out << "Tabu Tenure: `" << tabuTenure << "' states" << std::endl;
+	if ( initializer != NULL ) initializer->configuration(out);
+	if ( canonicalizer != NULL ) canonicalizer->configuration(out);
+	if ( enumerationMoves != 0 )
+		out << "Enumeration: `" << enumerationMoves << "' moves from the previous solution, at least `"
+			<< minDistance << "' values apart from the last `" << recentSolutions.width() << "' solutions" << std::endl;
+	// Print configuration parameters specific for the algorithm used
+	conf->configuration(out);
+	out << "------------------------------------------------------" << std::endl;
+
+	return out;
+}
+
+std::ostream& LsProblemManager::statistics (std::ostream& out)
+{
+	out << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "-----------------Solution  Statistics-----------------" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "Elapsed time: `" << elapsedTime << "' sec" << std::endl;
+	// Print statistics specific for the algorithm used
+	conf->statistics(out);
+	if ( enumerationMoves != 0 )
+	{
+		out << "Distinct solutions: `" << distinctSolutions << "' in `" << enumerationTime << "' sec (`"
+			<< ( enumerationTime > 0.0 ? distinctSolutions / enumerationTime : 0.0 ) << "' per sec)" << std::endl;
+		out << "Rejected solutions: `" << rejectedSolutions << "' (repeated or too close)" << std::endl;
+	}
+	out << "------------------------------------------------------" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& LsProblemManager::memoryReport (std::ostream& out)
+{
+	out << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "--------------------Memory  Report--------------------" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	compact.memoryReport(out);
+	out << "Tabu list: `" << tabuAssignments.size() * sizeof(Assignment) << "' bytes" << std::endl;
+	if ( !penalties.empty() )
+	{
+		std::size_t 	bytes = penalties.capacity() * sizeof(FeaturePenalties) + penalizedVariables.capacity() * sizeof(naxos::NsIndex);
+		for ( std::vector<naxos::NsIndex>::const_iterator it = penalizedVariables.begin() ; it != penalizedVariables.end() ; ++it )
+			bytes += penalties[*it].capacity() * sizeof(FeaturePenalties::value_type);
+		out << "Penalties: `" << bytes << "' bytes" << std::endl;
+	}
+	out << "State buffers: `" << ( stateBuffer.capacity() + bestState.capacity() + iteratedState.capacity() ) * sizeof(int)
+		+ ( bestJournal.capacity() + iteratedJournal.capacity() ) * sizeof(bestJournal[0]) << "' bytes" << std::endl;
+	// A weight per constraint id, and in the index the indices of its variables, its offset, hash and walk, and two to four buckets
+	out << "Constraint weights: `" << constraintWeights.capacity() * sizeof(unsigned long) + constraintIndex.bytes() << "' bytes" << std::endl;
+	out << "Scratch buffers: `" << scratchVariables.capacity() * sizeof(VariablePtr) << "' bytes" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& LsProblemManager::HillConfiguration::configuration (std::ostream& out)
+{
+	out << "Algorithm used: Hill Climbing" << std::endl;
+	out << "Active Window allowing state repetitions: `" << maxStateRepeats << "' times" << std::endl;
+	out << "Max Attempts to avoid restart: `" << maxAvoidAttempts << "' times" << std:: endl;
+	out << "Walking Probability: `" << walkProb << "'" << std::endl;
+	out << "Constraint Weight Increment: `" << weightIncrement << "'" << (weightIncrement == 0 ? " (disabled)" : "") << std::endl;
+	out << "Guided Local Search penalty weight: `" << penaltyLambda << "'" << (penaltyLambda == 0 ? " (disabled)" : "") << std::endl;
+	if ( iteratedPerturbation != 0 )
+		out << "Iterated Local Search instead of restarts, perturbing: `" << iteratedPerturbation << "' moves at least" << std::endl;
+	if ( restartPolicy != NULL ) restartPolicy->configuration(out);
+	if ( elitePool != NULL )
+	{
+		elitePool->configuration(out);
+		out << "Perturbation of elite states: `" << perturbation << "' moves" << std::endl;
+		if ( importEvery != 0 )
+			out << "Import of better elite states every: `" << importEvery << "' steps" << std::endl;
+	}
+	// Print configuration parameters specific for the heuristics used
+	variableHeuristic->configuration(out);
+	valueHeuristic->configuration(out);
+
+	return out;
+}
+
+std::ostream& LsProblemManager::HillConfiguration::statistics (std::ostream& out)
+{
+	out << "Restarted: `" << restarts << "' times" << std::endl;
+	out << "Max Steps ever reached: `" << maxSteps << "' steps" << std::endl;
+	out << "In last iteration used: `" << steps << "' steps" << std::endl;
+	if ( elitePool != NULL )
+		out << "Restarted from elite states: `" << eliteRestarts << "' times" << std::endl;
+	if ( elitePool != NULL && importEvery != 0 )
+		out << "Imported better elite states: `" << eliteImports << "' times" << std::endl;
+	if ( weightIncrement != 0 )
+		out << "Constraint weights increased: `" << weightIncreases << "' times" << std::endl;
+	if ( penaltyLambda != 0 )
+		out << "Penalties increased: `" << penaltyIncreases << "' times" << std::endl;
+	if ( iteratedPerturbation != 0 )
+		out << "Iterated from local optima: `" << iterations << "' times, `" << acceptedIterations << "' accepted" << std::endl;
+
+	return out;
+}
+
+
+void LsProblemManager::HillConfiguration::saveCounters (std::vector<unsigned long>& counters)
+{
+	unsigned long values[] = {steps, maxSteps, restarts, eliteRestarts, weightIncreases, penaltyIncreases, iterations, acceptedIterations, eliteImports};
+	counters.assign( values, values + sizeof(values) / sizeof(values[0]) );
+}
+
+void LsProblemManager::HillConfiguration::loadCounters (const std::vector<unsigned long>& counters)
+{
+	naxos::assert_Ns( counters.size() == 9, "HillConfiguration::loadCounters: Wrong number of counters" );
+	steps = counters[0]; maxSteps = counters[1]; restarts = counters[2]; eliteRestarts = counters[3]; weightIncreases = counters[4];
+	penaltyIncreases = counters[5]; iterations = counters[6]; acceptedIterations = counters[7]; eliteImports = counters[8];
+}
+
+
+std::ostream& LsProblemManager::AnnealingConfiguration::configuration (std::ostream& out)
+{
+	out << "Algorithm used: Simulated Annealing" << std::endl;
+	// Print configuration parameters specific for the scheduler used
+	scheduler->configuration(out);
+
+	return out;
+}
+
+std::ostream& LsProblemManager::AnnealingConfiguration::statistics (std::ostream& out)
+{
+	out << "Restarted: `" << restarts << "' times" << std::endl;
+	out << "In last iteration used: `" << steps << "' steps" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& LsProblemManager::LateAcceptanceConfiguration::configuration (std::ostream& out)
+{
+	out << "Algorithm used: Late Acceptance Hill Climbing" << std::endl;
+	out << "History length: `" << historyLength << "' steps" << std::endl;
+
+	return out;
+}
+
+std::ostream& LsProblemManager::LateAcceptanceConfiguration::statistics (std::ostream& out)
+{
+	out << "Used: `" << steps << "' steps" << std::endl;
+	out << "Accepted: `" << acceptedSteps << "' steps" << std::endl;
+
+	return out;
+}
+
+void LsProblemManager::LateAcceptanceConfiguration::saveCounters (std::vector<unsigned long>& counters)
+{
+	unsigned long values[] = {steps, acceptedSteps};
+	counters.assign( values, values + sizeof(values) / sizeof(values[0]) );
+}
+
+void LsProblemManager::LateAcceptanceConfiguration::loadCounters (const std::vector<unsigned long>& counters)
+{
+	naxos::assert_Ns( counters.size() == 2, "LateAcceptanceConfiguration::loadCounters: Wrong number of counters" );
+	steps = counters[0]; acceptedSteps = counters[1];
+}
+
+
+std::ostream& DihedralCanonicalizer::configuration (std::ostream& out)
+{
+	out << "Symmetric solutions: Rotations and reflections of the board count as one" << std::endl;
+
+	return out;
+}
+
+std::ostream& ColorCanonicalizer::configuration (std::ostream& out)
+{
+	out << "Symmetric solutions: Permutations of the colors count as one" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& RestartPolicy::configuration (std::ostream& out)
+{
+	out << "Restart unit: `" << unitSteps << "' steps" << std::endl;
+
+	return out;
+}
+
+std::ostream& FixedRestartPolicy::configuration (std::ostream& out)
+{
+	out << "Restart policy used: Fixed" << std::endl;
+
+	RestartPolicy::configuration(out);
+
+	return out;
+}
+
+std::ostream& GeometricRestartPolicy::configuration (std::ostream& out)
+{
+	out << "Restart policy used: Geometric" << std::endl;
+	out << "Parameter `factor': `" << factor << "'" << std::endl;
+
+	RestartPolicy::configuration(out);
+
+	return out;
+}
+
+std::ostream& LubyRestartPolicy::configuration (std::ostream& out)
+{
+	out << "Restart policy used: Luby" << std::endl;
+
+	RestartPolicy::configuration(out);
+
+	return out;
+}
+
+std::ostream& ElitePool::configuration (std::ostream& out)
+{
+	out << "Elite pool capacity: `" << capacity << "' states" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& RandomInitializer::configuration (std::ostream& out)
+{
+	out << "Initialization: Random" << std::endl;
+
+	return out;
+}
+
+std::ostream& PermutationInitializer::configuration (std::ostream& out)
+{
+	out << "Initial values: Random permutation" << std::endl;
+
+	return out;
+}
+
+std::ostream& GreedyInitializer::configuration (std::ostream& out)
+{
+	const char* orders[] = {"index", "random", "degree"};
+
+	out << "Initialization: Greedy Min Conflicts in " << orders[order] << " order" << std::endl;
+	out << "Values tried per variable: `" << maxTries << "'" << (maxTries == 0 ? " (whole domain)" : "") << std::endl;
+	if ( groups != NULL || differentNeighbours )
+		out << "Conflicts counted from:" << (groups != NULL ? " difference groups" : "") << (differentNeighbours ? " different neighbours" : "") << std::endl;
+
+	return out;
+}
+
+std::ostream& DsaturInitializer::configuration (std::ostream& out)
+{
+	out << "Initialization: DSATUR" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& SampledConflictingVariable::configuration (std::ostream& out)
+{
+	out << "Variable Heuristic: Sampled Max Conflicting" << std::endl;
+	out << "Sample size: `" << sampleSize << "'" << (sampleSize == 0 ? " (adaptive)" : "") << std::endl;
+
+	return out;
+}
+
+std::ostream& SampledBestImprovementVariable::configuration (std::ostream& out)
+{
+	out << "Variable Heuristic: Sampled Best Improvement" << std::endl;
+	out << "Sample size: `" << sampleSize << "'" << (sampleSize == 0 ? " (adaptive)" : "") << std::endl;
+
+	return out;
+}
+
+
+void LsProblemManager::AnnealingConfiguration::saveCounters (std::vector<unsigned long>& counters)
+{
+	unsigned long values[] = {steps, restarts};
+	counters.assign( values, values + sizeof(values) / sizeof(values[0]) );
+}
+
+void LsProblemManager::AnnealingConfiguration::loadCounters (const std::vector<unsigned long>& counters)
+{
+	naxos::assert_Ns( counters.size() == 2, "AnnealingConfiguration::loadCounters: Wrong number of counters" );
+	steps = counters[0]; restarts = counters[1];
 }
 
 
@@ -10,7 +10,11 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <map>
+#include <set>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 
 namespace localS
@@ -19,6 +23,7 @@ namespace localS
 
 typedef naxos::NsIntVar* 				VariablePtr;
 typedef std::pair<VariablePtr, naxos::NsInt> 		Assignment;
+typedef std::pair<VariablePtr, VariablePtr> 		Swap;
 
 typedef naxos::NsList<naxos::NsIntVar*> 		ConfVariables;
 typedef naxos::NsList<naxos::NsList<naxos::NsIntVar*> > ConfConstraints;
@@ -26,6 +31,16 @@ typedef ConfVariables::iterator 			ConfVarsIterator;
 typedef ConfConstraints::iterator 			ConfConstrIterator;
 typedef std::vector<ConfVarsIterator> 			ItVector;
 typedef std::vector<naxos::NsInt> 			ValueVector;
+// Compact copy of the values of the labeled variables, indexed by `lsIndex()'
+typedef std::vector<int> 				StateVector;
+// Neighbours of every labeled variable in the constraint graph, indexed by `lsIndex()'
+typedef std::vector<std::vector<naxos::NsIndex> > 	ConstraintGraph;
+// Labeled variables that must take pairwise different values once shifted, i.e. an `NsAllDiff' over
+// the expressions `Var[i] + shift'; Each member is the pair (lsIndex(), shift)
+typedef std::vector<std::pair<naxos::NsIndex, naxos::NsInt> > 	DifferenceGroup;
+typedef std::vector<DifferenceGroup> 				DifferenceGroups;
+
+typedef unsigned long 					StateHash;
 
 
 class LsProblemManager;
@@ -47,6 +62,17 @@ public:
 	virtual VariablePtr select (void) = 0;
 	
 	virtual std::ostream& configuration (std::ostream& out) { return out; };
+
+	// Whether `select()' draws from the dense conflict set of the problem manager on every step;
+	// Hill Climbing then keeps the set up to date on every assignment instead of rebuilding it
+	virtual bool drawsConflicts (void) { return false; }
+
+protected:
+
+	// Fills `positions' with up to `sampleSize' distinct random positions of a set with `setSize'
+	// elements, in increasing order so that the set can be walked once;
+	// A zero `sampleSize' adapts to the square root of the set size
+	void samplePositions (unsigned long setSize, unsigned long sampleSize, std::vector<unsigned long>& positions);
 };
 
 
@@ -70,6 +96,34 @@ public:
 };
 
 
+////////////////////////////////////// Initializer //////////////////////////////////////
+
+// Assigns a value to every (unassigned) variable at the beginning of each search process
+class Initializer
+{
+
+protected:
+
+	LsProblemManager& pm;
+	// The constraint graph for the initializers that need one;
+	// When NULL, the graph given to the problem manager, kept in its compact model
+	const ConstraintGraph* graph;
+
+	bool hasGraph (void);
+	naxos::NsIndex degree (naxos::NsIndex);
+	naxos::NsIndex neighbour (naxos::NsIndex, naxos::NsIndex);
+
+public:
+
+	Initializer (LsProblemManager& pm_, const ConstraintGraph* graph_ = NULL) : pm(pm_), graph(graph_) {}
+	virtual ~Initializer(void) {}
+
+	virtual void assign (naxos::NsIntVarArray&) = 0;
+	
+	virtual std::ostream& configuration (std::ostream& out) { return out; };
+};
+
+
 ////////////////////////////////////// ValueHeuristic //////////////////////////////////////
 
 // Scheduler for the Simulated Annealing algorithm
@@ -87,6 +141,8 @@ public:
 	virtual ~TemperatureScheduler(void) {}
 
 	virtual double operator[] (unsigned long) = 0;
+	// Continue from the given step, e.g. of a restored checkpoint, for schedulers that follow on from the previous one
+	virtual void resume (unsigned long) {}
 	
 	unsigned long stablePeriod () { return stableSteps; }
 	
@@ -94,542 +150,2058 @@ public:
 };
 
 
+////////////////////////////////////// RestartPolicy //////////////////////////////////////
 
-////////////////////////////////////// LsProblemManager //////////////////////////////////////
-
-class LsProblemManager : public naxos::NsProblemManager
+// Decides how many steps each Hill Climbing iteration may take before it is restarted
+class RestartPolicy
 {
 
-public:
+protected:
 
-	enum Algorithm {HILL, ANNEALING};
+	LsProblemManager& pm;
+	unsigned long unitSteps;
 
-	////////////////////////////////////// Configuration //////////////////////////////////////
+public:
 
-	struct Configuration
-	{
-		virtual ~Configuration(void) {}
+	RestartPolicy (LsProblemManager& pm_, unsigned long unitSteps_) : pm(pm_), unitSteps(unitSteps_) {}
+	virtual ~RestartPolicy(void) {}
 
-		virtual Algorithm algorithm (void) = 0;
-		virtual std::ostream& configuration (std::ostream&) = 0;
-		virtual std::ostream& statistics (std::ostream&) = 0;
-	};
+	// Steps allowed in the iteration following the given number of restarts
+	virtual unsigned long operator[] (unsigned long) = 0;
 
-	////////////////////////////////////// HillConfiguration //////////////////////////////////////
+	virtual std::ostream& configuration (std::ostream&);
+};
 
-	// Configuration for the Hill Climbing algorithm
-	struct HillConfiguration : public Configuration
-	{
-		VariableHeuristic* 	variableHeuristic;
-		ValueHeuristic* 	valueHeuristic;
-		unsigned long 		maxStateRepeats;
-		unsigned long 		maxAvoidAttempts;
-		double	 		walkProb;
-		unsigned long 		steps;
-		unsigned long 		maxSteps;
-		unsigned long 		restarts;
 
-		HillConfiguration (VariableHeuristic* variableHeuristic_, ValueHeuristic* valueHeuristic_,
-				unsigned long maxStateRepeats_, unsigned long maxAvoidAttempts_ = 5, double walkProb_ = 0.0) :
-				variableHeuristic(variableHeuristic_), valueHeuristic(valueHeuristic_),
-				maxStateRepeats(maxStateRepeats_), maxAvoidAttempts(maxAvoidAttempts_), walkProb(walkProb_) {}
+////////////////////////////////////// ElitePool //////////////////////////////////////
 
-		Algorithm algorithm (void) { return HILL; }
-		std::ostream& configuration (std::ostream&);
-		std::ostream& statistics (std::ostream&);
-	};
+// Bounded pool of the states with the fewest conflicts met at the end of Hill Climbing iterations;
+// Restarts begin from a perturbed copy of one of them instead of a random state
+class ElitePool
+{
 
-	////////////////////////////////////// AnnealingConfiguration //////////////////////////////////////
+protected:
 
-	// Configuration for the Simulated Annealing algorithm
-	struct AnnealingConfiguration : public Configuration
+	struct EliteState
 	{
-		TemperatureScheduler* 	scheduler;
-		unsigned long 		steps;
-		unsigned long 		restarts;
-
-		AnnealingConfiguration (TemperatureScheduler* scheduler_) : scheduler(scheduler_) {}
-
-		Algorithm algorithm (void) { return ANNEALING; }
-		std::ostream& configuration (std::ostream&);
-		std::ostream& statistics (std::ostream&);
+		StateVector 	values;
+		unsigned long 	conflicts;
 	};
 
-protected:
+	unsigned int 		capacity;
+	std::vector<EliteState> states;
 
-	naxos::NsIntVarArray* 		varArray;
-	// Record all previous solutions found so as to report only new ones
-	ActiveWindow<std::string> previousSolutions;
-	// Elapsed time for the most recent solution found
-	double 				elapsedTime;
+public:
 
-	// Configurations specific to the algorithm in use
-	Algorithm 			usingAlgorithm;
-	Configuration* 			conf;
+	ElitePool (unsigned int capacity_) : capacity(capacity_) { states.reserve(capacity); }
+	virtual ~ElitePool(void) {}
 
-	// For Tabu Search
-	unsigned long 			tabuTenure;
-	ActiveWindow<Assignment> 	tabuAssignments;
-	// The best minConflicts found while searching for a solution;
-	// Used for the aspiration criterion (improvement in the incumbent candidate solution)
-	naxos::NsInt 			globalMinConflicts;
+	unsigned int size (void) { return states.size(); }
 
-	unsigned long 			seed;
+	// Number of conflicts a state must beat to enter the (full) pool
+	virtual unsigned long threshold (void);
 
+	// Keeps a copy of the state if it improves the pool; returns whether it was kept
+	virtual bool publish (const StateVector&, unsigned long);
+	// Copies a random state of the pool; returns false when the pool is empty
+	virtual bool sample (StateVector&, MTRand_int32&);
 
-	void initialize (void);
-	void reset (void);
+	// Fewest conflicts of a state in the pool, or `NsUPLUS_INF' when it is empty
+	virtual unsigned long best (void);
+	// Copies a random state with fewer conflicts than the given ones; returns false when there is none
+	virtual bool sampleBetter (StateVector&, MTRand_int32&, unsigned long);
 
-	void solveHill (void);
-	void solveAnnealing (void);
+	virtual std::ostream& configuration (std::ostream&);
+};
 
-	std::string hashState(naxos::NsIndex, naxos::NsInt);
 
-public:
 
-	// Declared as public so that other classes can use the same instance to produce random numbers
-	MTRand_int32 	random;
+////////////////////////////////////// SolutionCallback //////////////////////////////////////
 
+// Receives every new solution found by `nextSolution()', as the values of the labeled variables in order
+class SolutionCallback
+{
 
-	LsProblemManager (unsigned long tabuTenure_ = 1, unsigned long seed_ = 1) : varArray(NULL), conf(NULL),
-			tabuTenure(tabuTenure_), tabuAssignments(tabuTenure), seed(seed_), random(seed) { }
-	virtual ~LsProblemManager (void) {}
+public:
 
-	void label (naxos::NsIntVarArray& varArray_, Configuration* conf_);
-	void nextSolution (void);
+	virtual ~SolutionCallback(void) {}
 
-	bool tryAssignment (Assignment);
-	void commitAssignment (Assignment);
-	void revertToAssignment (Assignment);
+	virtual void operator() (const int* values, naxos::NsIndex size) = 0;
+};
 
-	std::ostream& solutionToString (std::ostream&);
-	std::ostream& configuration (std::ostream&);
-	std::ostream& statistics (std::ostream&);
 
-	void printTabu(void)
-	{
-		std::cerr << "\t\t\t\t\t\t\t\t\t\tTABU LIST: ";
-		for (ActiveWindow<Assignment>::iterator it = tabuAssignments.begin() ; it != tabuAssignments.end() ; it++)
-			std::cerr << "| " << it->first->lsIndex() << " - " << it->second << " ";
-		std::cerr << std::endl;
-	}
-};
+////////////////////////////////////// TextSolutionWriter //////////////////////////////////////
 
+// A line of space separated values per solution, formatted into a buffer reused for every solution
+class TextSolutionWriter : public SolutionCallback
+{
 
+private:
 
+	std::ostream& 		out;
+	std::vector<char> 	buffer;
 
+public:
 
-////////////////////////////////////// MaxConflictingVariable //////////////////////////////////////
+	TextSolutionWriter (std::ostream& out_) : out(out_) {}
 
-// Returns variable participating in the most violated constraints
-struct MaxConflictingVariable : public VariableHeuristic
-{
-	MaxConflictingVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+	void operator() (const int* values, naxos::NsIndex size);
 
-	VariablePtr select (void)
+	// Writes `value' in decimal at `p' and returns the end, like `std::to_chars';
+	// `p' must have room for 11 characters
+	static char* format (char* p, int value)
 	{
-		int 		maxViolations = 0;
-		ItVector 	maxIts;
-		ConfVariables 	conflictSet = pm.lsConflictingVars();
-		for ( ConfVarsIterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		unsigned int 	magnitude = static_cast<unsigned int>(value);
+		if ( value < 0 )
 		{
-			int currentViolations = (*it)->lsViolatedConstraints().size();
-			if ( currentViolations > maxViolations )
-			{
-				maxViolations = currentViolations;
-				maxIts.clear();
-			}
-			if ( currentViolations == maxViolations ) maxIts.push_back(it);
+			*p++ = '-';
+			magnitude = 0U - magnitude;
 		}
 
-		// Tie break is random
-		return *maxIts[ pm.random( maxIts.size() ) ];
+		char 	digits[10];
+		int 	count = 0;
+		do {
+			digits[count++] = static_cast<char>( '0' + magnitude % 10 );
+			magnitude /= 10;
+		} while ( magnitude != 0 );
+		while ( count != 0 ) *p++ = digits[--count];
+
+		return p;
 	}
 };
 
 
-////////////////////////////////////// MinConflictingVariable //////////////////////////////////////
+////////////////////////////////////// BinarySolutionWriter //////////////////////////////////////
 
-// Returns variable participating in the least violated constraints
-struct MinConflictingVariable : public VariableHeuristic
+// The values of every solution as 32 bit little endian integers, one solution after the other
+class BinarySolutionWriter : public SolutionCallback
 {
-	MinConflictingVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
 
-	VariablePtr select (void)
+private:
+
+	std::ostream& 			out;
+	std::vector<unsigned char> 	buffer;
+
+public:
+
+	BinarySolutionWriter (std::ostream& out_) : out(out_) {}
+
+	void operator() (const int* values, naxos::NsIndex size);
+
+	// Writes `size' values at `p' in little endian order; `p' must have room for `4 * size' bytes
+	static void encode (unsigned char* p, const int* values, naxos::NsIndex size)
 	{
-		ConfVariables 	conflictSet = pm.lsConflictingVars();
-		int 		minViolations = (*conflictSet.begin())->lsViolatedConstraints().size();
-		ItVector 	minIts;
-		for ( ConfVarsIterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		for ( naxos::NsIndex i = 0 ; i < size ; i++, p += 4 )
 		{
-			int currentViolations = (*it)->lsViolatedConstraints().size();
-			if ( currentViolations < minViolations )
-			{
-				minViolations = currentViolations;
-				minIts.clear();
-			}
-			if ( currentViolations == minViolations ) minIts.push_back(it);
+			unsigned int value = static_cast<unsigned int>( values[i] );
+			p[0] = static_cast<unsigned char>( value );
+			p[1] = static_cast<unsigned char>( value >> 8 );
+			p[2] = static_cast<unsigned char>( value >> 16 );
+			p[3] = static_cast<unsigned char>( value >> 24 );
 		}
-
-		// Tie break is random
-		return *minIts[ pm.random( minIts.size() ) ];
 	}
 };
 
 
-////////////////////////////////////// FirstVariable //////////////////////////////////////
+#if defined(__unix__) || defined(__APPLE__)
+#define LOCAL_S_MAPPED_WRITER
 
-// Returns the first variable
-struct FirstVariable : public VariableHeuristic
+////////////////////////////////////// MappedSolutionWriter //////////////////////////////////////
+
+// Like BinarySolutionWriter, but copies straight into a memory-mapped file, grown by doubling;
+// The file is cut to the bytes written when the writer is destroyed
+class MappedSolutionWriter : public SolutionCallback
 {
-	FirstVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
 
-	VariablePtr select (void)
-	{
-		ConfVariables conflictSet = pm.lsConflictingVars();
-		return *conflictSet.begin();
-	}
-};
+private:
 
+	int 			file;
+	unsigned char* 		mapping;
+	unsigned long 		capacity;
+	unsigned long 		written;
 
-////////////////////////////////////// BiggestDomainVariable //////////////////////////////////////
+	void grow (unsigned long);
 
-// Returns variable with the biggest domain
-struct BiggestDomainVariable : public VariableHeuristic
-{
-	BiggestDomainVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+	// Not copyable; the mapping is owned
+	MappedSolutionWriter (const MappedSolutionWriter&);
+	void operator= (const MappedSolutionWriter&);
 
-	VariablePtr select (void)
-	{
-		unsigned int 	biggestDomain = 0;
-		ItVector 	biggestIts;
-		ConfVariables 	conflictSet = pm.lsConflictingVars();
-		for ( ConfVarsIterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
-		{
-			unsigned int currentSize = (*it)->size();
-			if ( currentSize > biggestDomain )
-			{
-				biggestDomain = currentSize;
-				biggestIts.clear();
-			}
-			if ( currentSize == biggestDomain ) biggestIts.push_back(it);
-		}
+public:
 
-		// Tie break is random
-		return *biggestIts[ pm.random( biggestIts.size() ) ];
-	}
+	MappedSolutionWriter (const std::string& path);
+	~MappedSolutionWriter (void);
+
+	void operator() (const int* values, naxos::NsIndex size);
 };
 
+#endif
 
-////////////////////////////////////// SmallestDomainVariable //////////////////////////////////////
 
-// Returns variable with the smallest domain
-struct SmallestDomainVariable : public VariableHeuristic
+
+////////////////////////////////////// MappedFile //////////////////////////////////////
+
+// A file read whole, memory-mapped where the platform allows it, otherwise read into a buffer
+class MappedFile
 {
-	SmallestDomainVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
 
-	VariablePtr select (void)
-	{
-		ConfVariables 	conflictSet = pm.lsConflictingVars();
-		unsigned int 	smallestDomain = (*conflictSet.begin())->size();
-		ItVector 	smallestIts;
-		for ( ConfVarsIterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
-		{
-			unsigned int currentSize = (*it)->size();
-			if ( currentSize < smallestDomain )
-			{
-				smallestDomain = currentSize;
-				smallestIts.clear();
-			}
-			if ( currentSize == smallestDomain ) smallestIts.push_back(it);
-		}
+private:
 
-		// Tie break is random
-		return *smallestIts[ pm.random( smallestIts.size() ) ];
-	}
+	const char* 		bytes;
+	unsigned long 		length;
+	void* 			mapping;
+	std::string 		buffer;
+
+	// Not copyable; the mapping is owned
+	MappedFile (const MappedFile&);
+	void operator= (const MappedFile&);
+
+public:
+
+	MappedFile (const std::string& path);
+	~MappedFile (void);
+
+	const char* data (void) const { return bytes; }
+	unsigned long size (void) const { return length; }
 };
 
 
-////////////////////////////////////// RandomVariable //////////////////////////////////////
+// The words of the binary files, 32 bit little endian
+inline void appendWord (std::string& out, unsigned int word)
+{
+	char 	p[4] = { static_cast<char>(word), static_cast<char>(word >> 8), static_cast<char>(word >> 16), static_cast<char>(word >> 24) };
+	out.append( p, 4 );
+}
 
-// Returns a variable at random
-struct RandomVariable : public VariableHeuristic
+inline unsigned int readWord (const char* p)
 {
-	RandomVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+	const unsigned char* 	q = reinterpret_cast<const unsigned char*>(p);
+	return q[0] | (q[1] << 8) | (q[2] << 16) | (static_cast<unsigned int>(q[3]) << 24);
+}
 
-	VariablePtr select (void)
+// Fills `words' with the `count' words at `p'; A little endian host copies them as they are
+inline void readWords (const char* p, unsigned long count, std::vector<unsigned int>& words)
+{
+	words.resize( count );
+	if ( count == 0 ) return;
+	const unsigned int 	one = 1;
+	if ( sizeof(unsigned int) == 4 && *reinterpret_cast<const unsigned char*>(&one) == 1 )
 	{
-		ConfVariables 		conflictSet = pm.lsConflictingVars();
-		int 			selection = pm.random( conflictSet.size() );
-		ConfVarsIterator 	it;
-		for ( it = conflictSet.begin() ; it != conflictSet.end() ; it++, selection-- )
-			if ( selection == 0 ) break;
-
-		return *it;
+		std::memcpy( &words[0], p, 4 * count );
+		return;
 	}
-};
-
+	for ( unsigned long k = 0 ; k < count ; k++, p += 4 ) words[k] = readWord( p );
+}
 
 
 
-////////////////////////////////////// MinConflictingValue //////////////////////////////////////
+////////////////////////////////////// TraceRecorder //////////////////////////////////////
 
-// Select value for selected variable that minimizes violated constraints
-struct MinConflictingValue : public ValueHeuristic
+// Samples the progress of the searches into a ring allocated once: the step, the wall-clock time since the recorder
+// was created or cleared (monotonic where the platform has such a clock), the violated constraints, the temperature (zero but for annealing) and the restarts since
+// the previous sample; Step `s' is sampled once `s' reaches `growth' times the previously sampled step, so a run
+// of `S' steps takes about log(S) / log(growth) samples and the ring rarely wraps around
+class TraceRecorder
 {
-	MinConflictingValue (LsProblemManager& pm_) : ValueHeuristic(pm_) { }
 
-	naxos::NsInt select (naxos::NsIntVar& variable)
+public:
+
+	struct Sample
 	{
-		using namespace naxos;
+		unsigned long 	step;
+		double 		time;
+		unsigned long 	conflicts;
+		double 		temperature;
+		unsigned long 	restarts;
+	};
 
-		NsInt 	confValue = variable.lsValue();
-		NsInt 	minConflicts = pm.lsViolatedConstraints().size();
-		NsInt 	minConfValue = confValue;
-		for ( NsInt currentValue = variable.min() ; currentValue <= variable.max() ; currentValue = variable.next(currentValue) )
-		{
-			// Skip assignment if it is the same as the current one
-			if ( currentValue == confValue ) continue;
+private:
 
-			// Try to assign the current value; it will fail if the assignment isn't allowed
-			// On failure skip the current value and try the next one
-			if ( !pm.tryAssignment( std::make_pair(&variable, currentValue) ) ) continue;
+	std::vector<Sample> 	samples;
+	unsigned long 		head;
+	unsigned long 		count;
+	double 			growth;
+	unsigned long 		steps;
+	unsigned long 		nextSample;
+	unsigned long 		restarts;
+	double 			started;
 
-			NsInt currentConflicts = pm.lsViolatedConstraints().size();
-			if ( currentConflicts < minConflicts )
-			{
-				// Update best assignment
-				minConflicts = currentConflicts;
-				minConfValue = currentValue;
-			}
-		}
+public:
 
-		// Commit final assignment
-		pm.commitAssignment( std::make_pair(&variable, minConfValue) );
+	TraceRecorder (unsigned long capacity = 4096, double growth_ = 1.01);
 
-		return minConfValue;
-	}
+	// Counts a step; True when the step is due to be recorded
+	bool tick (void) { return ++steps >= nextSample; }
+	void restarted (void) { restarts++; }
+	void record (unsigned long conflicts, double temperature);
+
+	void clear (void);
+	unsigned long size (void) const { return count; }
+	// The samples in order, the oldest first
+	const Sample& operator[] (unsigned long i) const { return samples[ (head + i) % samples.size() ]; }
+
+	// A header line and a line per sample
+	std::ostream& writeCsv (std::ostream&) const;
+	// The magic "LSTRACE1", the number of samples and the samples, each field 8 bytes little endian
+	std::ostream& writeBinary (std::ostream&) const;
 };
 
 
-////////////////////////////////////// RandomValue //////////////////////////////////////
+////////////////////////////////////// SolutionCanonicalizer //////////////////////////////////////
 
-// Select value at random
-struct RandomValue : public ValueHeuristic
+// Maps a solution to the representative of its symmetry class, so that solutions symmetric
+// to one already found count as found
+class SolutionCanonicalizer
 {
-	RandomValue(LsProblemManager& pm_) : ValueHeuristic(pm_) {}
 
-	naxos::NsInt select (naxos::NsIntVar& variable)
-	{
-		using namespace naxos;
+public:
 
-		int 	selection = pm.random( variable.size() );
+	virtual ~SolutionCanonicalizer(void) {}
+
+	// `canonical' receives the representative of `values'; both are the values of the labeled variables
+	virtual void canonicalize (const StateVector& values, StateVector& canonical) = 0;
+
+	virtual std::ostream& configuration (std::ostream& out) { return out; };
+};
+
+
+////////////////////////////////////// DihedralCanonicalizer //////////////////////////////////////
+
+// N-Queens, with the queen of row `i' on column `values[i]' in [0, N); The least (lexicographically)
+// of the 8 rotations and reflections of the board, in O(N) each
+struct DihedralCanonicalizer : public SolutionCanonicalizer
+{
+
+private:
+
+	StateVector 	candidate;
+
+public:
+
+	void canonicalize (const StateVector& values, StateVector& canonical);
+
+	std::ostream& configuration (std::ostream&);
+};
+
+
+////////////////////////////////////// ColorCanonicalizer //////////////////////////////////////
+
+// Graph coloring, with colors from `firstColor'; Relabels the colors in the order they first appear,
+// so that solutions differing by a permutation of the colors are the same, in O(n + colors)
+struct ColorCanonicalizer : public SolutionCanonicalizer
+{
+
+private:
+
+	int 			firstColor;
+	std::vector<int> 	relabel;
+
+public:
+
+	ColorCanonicalizer (int firstColor_ = 0) : firstColor(firstColor_) {}
+
+	void canonicalize (const StateVector& values, StateVector& canonical);
+
+	std::ostream& configuration (std::ostream&);
+};
+
+
+////////////////////////////////////// CompactModel //////////////////////////////////////
+
+// What local search reads on every step, copied out of the naxos model at `label()' into flat arrays:
+// The current values, the domains and the constraint graph in compressed sparse row form
+class CompactModel
+{
+
+public:
+
+	// The interval [min, max] when `offset' is INTERVAL, else the `size' values from `offset' in `domainValues'
+	struct Domain
+	{
+		int 		min;
+		int 		max;
+		unsigned int 	size;
+		unsigned int 	offset;
+	};
+	static const unsigned int INTERVAL = ~0U;
+
+	std::vector<int> 		values;
+	std::vector<Domain> 		domains;
+	// Consecutive variables with the same domain share its values
+	std::vector<int> 		domainValues;
+	// The neighbours of variable `i' are neighbours[ neighbourOffsets[i] ... neighbourOffsets[i+1] );
+	// Both empty when no constraint graph was given
+	std::vector<unsigned int> 	neighbourOffsets;
+	std::vector<unsigned int> 	neighbours;
+
+	void build (naxos::NsIntVarArray&, const ConstraintGraph*);
+
+	bool hasGraph (void) const { return !neighbourOffsets.empty(); }
+	naxos::NsIndex degree (naxos::NsIndex i) const { return neighbourOffsets[i + 1] - neighbourOffsets[i]; }
+	naxos::NsIndex neighbour (naxos::NsIndex i, naxos::NsIndex k) const { return neighbours[ neighbourOffsets[i] + k ]; }
+
+	// The value at `position' in the domain of variable `i'
+	int domainValue (naxos::NsIndex i, unsigned long position) const
+	{
+		const Domain& domain = domains[i];
+		if ( domain.offset == INTERVAL ) return domain.min + static_cast<int>(position);
+		return domainValues[ domain.offset + position ];
+	}
+
+	std::ostream& memoryReport (std::ostream&) const;
+};
+
+
+////////////////////////////////////// ConstraintIndex //////////////////////////////////////
+
+// Dense ids for the constraints met in the violated lists, assigned on first sight; naxos gives a violated constraint
+// only as its variables, so it is identified by their indices, compared in full on every lookup; Constraints over the
+// same variables cannot be told apart, since their order in a violated list changes with which of them are violated,
+// and they share one id
+class ConstraintIndex
+{
+
+private:
+
+	// The indices of the variables of constraint `c' are members[ offsets[c] ... offsets[c+1] - 1 ];
+	// `hashes[c]' is its hash, for growing the table
+	std::vector<naxos::NsIndex> 	members;
+	std::vector<unsigned long> 	offsets;
+	std::vector<unsigned long> 	hashes;
+	// Open addressing; the id plus one, or zero when empty, and grown so that at most half is used
+	std::vector<unsigned long> 	buckets;
+	// The walk in which every id was last met, so that a walk can tell the constraints sharing an id
+	std::vector<unsigned long> 	lastWalk;
+	unsigned long 			walk;
+	// The indices of the variables of the constraint being looked up
+	std::vector<naxos::NsIndex> 	lookup;
+
+	static unsigned long hash (const std::vector<naxos::NsIndex>& indices);
+	// The bucket of the constraint, or the empty one where it would go
+	unsigned long bucket (const std::vector<naxos::NsIndex>& indices, unsigned long key) const;
+	unsigned long insert (unsigned long bucket, const std::vector<naxos::NsIndex>& indices, unsigned long key);
+	void grow (void);
+
+public:
+
+	ConstraintIndex (void) : offsets(1, 0), buckets(64, 0), walk(0) {}
+
+	// The id of a constraint of a violated list
+	unsigned long id (const ConfVariables& constraint);
+	// The id of the constraint over the variables of the given indices, e.g. from a checkpoint
+	unsigned long id (const std::vector<naxos::NsIndex>& indices);
+	// The indices of the variables of a constraint
+	void key (unsigned long id, std::vector<naxos::NsIndex>& indices) const;
+	unsigned long size (void) const { return offsets.size() - 1; }
+
+	// A walk over a violated list starts with `startWalk()'; `firstInWalk()' is true for an id met for the first time in it
+	void startWalk (void) { walk++; }
+	bool firstInWalk (unsigned long id);
+
+	unsigned long bytes (void) const;
+};
+
+
+////////////////////////////////////// LsProblemManager //////////////////////////////////////
+
+class LsProblemManager : public naxos::NsProblemManager
+{
+
+public:
+
+	enum Algorithm {HILL, ANNEALING, LATE_ACCEPTANCE};
+
+	static const unsigned long NO_STREAM = ~0UL;
+
+	////////////////////////////////////// Configuration //////////////////////////////////////
+
+	struct Configuration
+	{
+		virtual ~Configuration(void) {}
+
+		virtual Algorithm algorithm (void) = 0;
+		virtual std::ostream& configuration (std::ostream&) = 0;
+		virtual std::ostream& statistics (std::ostream&) = 0;
+
+		// The statistics counters, saved in and restored from checkpoints
+		virtual void saveCounters (std::vector<unsigned long>&) {}
+		virtual void loadCounters (const std::vector<unsigned long>&) {}
+	};
+
+	////////////////////////////////////// HillConfiguration //////////////////////////////////////
+
+	// Configuration for the Hill Climbing algorithm
+	struct HillConfiguration : public Configuration
+	{
+		VariableHeuristic* 	variableHeuristic;
+		ValueHeuristic* 	valueHeuristic;
+		unsigned long 		maxStateRepeats;
+		unsigned long 		maxAvoidAttempts;
+		double	 		walkProb;
+		// Constraint Weighting (breakout); zero disables it
+		unsigned long 		weightIncrement;
+		// Optional; Restart also when the policy's steps run out
+		RestartPolicy* 		restartPolicy;
+		// Optional; Restart from a copy of an elite state, changed by `perturbation' random moves
+		ElitePool* 		elitePool;
+		unsigned long 		perturbation;
+		// Optional; Every `importEvery' steps also offer the current state to the elite pool,
+		// and move to an elite state with fewer conflicts if there is one; zero disables it
+		unsigned long 		importEvery;
+		// Guided Local Search; the weight of the (variable, value) penalties in the augmented cost, zero disables it
+		unsigned long 		penaltyLambda;
+		// Iterated Local Search; On stagnation, the accepted local optimum is changed by `iteratedPerturbation'
+		// random moves instead of restarting, more while the search falls back to the same optima; zero disables it
+		unsigned long 		iteratedPerturbation;
+		unsigned long 		steps;
+		unsigned long 		maxSteps;
+		unsigned long 		restarts;
+		unsigned long 		eliteRestarts;
+		unsigned long 		eliteImports;
+		unsigned long 		weightIncreases;
+		unsigned long 		penaltyIncreases;
+		unsigned long 		iterations;
+		unsigned long 		acceptedIterations;
+
+		HillConfiguration (VariableHeuristic* variableHeuristic_, ValueHeuristic* valueHeuristic_,
+				unsigned long maxStateRepeats_, unsigned long maxAvoidAttempts_ = 5, double walkProb_ = 0.0,
+				unsigned long weightIncrement_ = 0) :
+				variableHeuristic(variableHeuristic_), valueHeuristic(valueHeuristic_),
+				maxStateRepeats(maxStateRepeats_), maxAvoidAttempts(maxAvoidAttempts_), walkProb(walkProb_),
+				weightIncrement(weightIncrement_), restartPolicy(NULL), elitePool(NULL), perturbation(0), importEvery(0), penaltyLambda(0), iteratedPerturbation(0) {}
+
+		Algorithm algorithm (void) { return HILL; }
+		std::ostream& configuration (std::ostream&);
+		std::ostream& statistics (std::ostream&);
+		void saveCounters (std::vector<unsigned long>&);
+		void loadCounters (const std::vector<unsigned long>&);
+	};
+
+	////////////////////////////////////// AnnealingConfiguration //////////////////////////////////////
+
+	// Configuration for the Simulated Annealing algorithm
+	struct AnnealingConfiguration : public Configuration
+	{
+		TemperatureScheduler* 	scheduler;
+		unsigned long 		steps;
+		unsigned long 		restarts;
+
+		AnnealingConfiguration (TemperatureScheduler* scheduler_) : scheduler(scheduler_) {}
+
+		Algorithm algorithm (void) { return ANNEALING; }
+		std::ostream& configuration (std::ostream&);
+		std::ostream& statistics (std::ostream&);
+		void saveCounters (std::vector<unsigned long>&);
+		void loadCounters (const std::vector<unsigned long>&);
+	};
+
+	////////////////////////////////////// LateAcceptanceConfiguration //////////////////////////////////////
+
+	// Configuration for the Late Acceptance Hill Climbing algorithm; A random move is accepted
+	// if it violates no more constraints than now, or than `historyLength' steps ago
+	struct LateAcceptanceConfiguration : public Configuration
+	{
+		unsigned long 		historyLength;
+		unsigned long 		steps;
+		unsigned long 		acceptedSteps;
+
+		LateAcceptanceConfiguration (unsigned long historyLength_) : historyLength(historyLength_)
+		{
+			naxos::assert_Ns( historyLength > 0, "LateAcceptanceConfiguration::LateAcceptanceConfiguration: The history must not be empty" );
+		}
+
+		Algorithm algorithm (void) { return LATE_ACCEPTANCE; }
+		std::ostream& configuration (std::ostream&);
+		std::ostream& statistics (std::ostream&);
+		void saveCounters (std::vector<unsigned long>&);
+		void loadCounters (const std::vector<unsigned long>&);
+	};
+
+protected:
+
+	naxos::NsIntVarArray* 		varArray;
+	// Record all previous solutions found so as to report only new ones
+	std::set<std::string> 		previousSolutions;
+	// Optional; solutions in the same symmetry class count as one
+	SolutionCanonicalizer* 		canonicalizer;
+	StateVector 			canonicalBuffer;
+	// Elapsed time for the most recent solution found
+	double 				elapsedTime;
+
+	// Configurations specific to the algorithm in use
+	Algorithm 			usingAlgorithm;
+	Configuration* 			conf;
+	// Assigns the initial values; random values when NULL
+	Initializer* 			initializer;
+	// The local search copy of the model; its values follow every assignment
+	CompactModel 			compact;
+	// Copied into the compact model by `label()'
+	const ConstraintGraph* 		constraintGraph;
+	// Called with every new solution; none when NULL
+	SolutionCallback* 		solutionCallback;
+	// Samples the progress of the searches; none when NULL
+	TraceRecorder* 			trace;
+	// Reused by `solutionToString()'
+	std::vector<char> 		outputBuffer;
+
+	// For Enumeration; every search after the first starts from the previous solution
+	// changed by `enumerationMoves' random moves, instead of from scratch when zero
+	unsigned long 			enumerationMoves;
+	// A new solution must differ in at least `minDistance' values from each of the `recentSolutions'
+	unsigned long 			minDistance;
+	ActiveWindow<StateVector> 	recentSolutions;
+	bool 				perturbPending;
+	unsigned long 			perturbMoves;
+	unsigned long 			distinctSolutions;
+	unsigned long 			rejectedSolutions;
+	double 				enumerationTime;
+
+	// For Tabu Search
+	unsigned long 			tabuTenure;
+	ActiveWindow<Assignment> 	tabuAssignments;
+	// How many of the tabu assignments are of variable `i'; Most variables have none, so that
+	// an assignment is known not to be tabu without searching the list
+	std::vector<unsigned int> 	tabuCounts;
+	// Pairs of variables recently swapped, the lesser pointer first
+	ActiveWindow<Swap> 		tabuSwaps;
+	// Random walks and perturbations swap values instead of reassigning a variable, and the
+	// initial state is a permutation, so that permutation (AllDiff) constraints stay satisfied
+	bool 				swapMoves;
+	// The best minConflicts found while searching for a solution;
+	// Used for the aspiration criterion (improvement in the incumbent candidate solution)
+	naxos::NsInt 			globalMinConflicts;
+
+	// For Constraint Weighting; every violated constraint weighs `1' unless its weight has been increased
+	// at a local minimum; The weights are indexed by the ids of `constraintIndex', which outlives them
+	unsigned long 			weightIncrement;
+	ConstraintIndex 		constraintIndex;
+	std::vector<unsigned long> 	constraintWeights;
+	// Total weight of the violated constraints, kept up to date on every assignment
+	unsigned long 			weightedConflicts;
+	// Weighted conflicts of the most recently assigned variable;
+	// Saves recomputing them when the same variable is tried again
+	VariablePtr 			cachedVariable;
+	unsigned long 			cachedVariableConflicts;
+
+	// For Guided Local Search; `penalties[i]' holds the penalized values of variable `i' with their
+	// penalties, as only a few features are ever penalized; `penalizedVariables' lists the variables
+	// with any, so that the next solve clears just those
+	typedef std::vector< std::pair<int, unsigned long> > 	FeaturePenalties;
+	unsigned long 			penaltyLambda;
+	std::vector<FeaturePenalties> 	penalties;
+	std::vector<naxos::NsIndex> 	penalizedVariables;
+	// Total penalty of the current assignments, kept up to date on every assignment
+	unsigned long 			currentPenalty;
+
+	// Dense set of the conflicting variables, so that one can be drawn at random without walking a list;
+	// `conflictCounts[i]' is the number of violated constraints of variable `i', and `conflictPositions[i]'
+	// its position in `conflictVariables' while the count isn't zero; With `trackConflicts', for the algorithms
+	// and heuristics drawing from it on every step, it is kept up to date on every assignment once built;
+	// Otherwise the heuristics walk the naxos list instead, as rebuilding the set costs a pass over all the
+	// violated constraints, and keeping it up to date for the occasional random walk slows down every assignment
+	std::vector<VariablePtr> 	conflictVariables;
+	std::vector<unsigned long> 	conflictPositions;
+	std::vector<unsigned long> 	conflictCounts;
+	bool 				trackConflicts;
+	bool 				conflictsTracked;
+
+	unsigned long 			seed;
+	// The stream of `seed' in use, NO_STREAM when seeded with `seed' itself
+	unsigned long 			stream;
+
+	// Reused on every restart so that capturing a state doesn't allocate
+	StateVector 			stateBuffer;
+
+	// Exclusive or of hashAssignment() over all the variables; kept up to date on every
+	// assignment, so that detecting repeated states costs O(1) instead of O(n) per step
+	StateHash 			currentHash;
+
+	// The undo journal of a tentative move, from `markMove()' on; The previous values of the assignments
+	// and the changes of the conflict counts, replayed in reverse by `undoMove()', and the totals kept
+	// on every assignment as they were at the mark, so that none of them is recomputed; The values are
+	// still set back in naxos
+	struct MoveJournal
+	{
+		bool 						recording;
+		std::vector<std::pair<VariablePtr, int> > 	assignments;
+		std::vector<std::pair<naxos::NsIndex, bool> > 	counts;
+		StateHash 					hash;
+		unsigned long 					weightedConflicts;
+		unsigned long 					penalty;
+		VariablePtr 					cachedVariable;
+		unsigned long 					cachedVariableConflicts;
+		bool 						conflictsTracked;
+		std::size_t 					bestJournalSize;
+		std::size_t 					iteratedJournalSize;
+
+		MoveJournal (void) : recording(false) {}
+	} 				moveJournal;
+
+	// For Checkpoints; saved every `checkpointSteps' steps, or every `checkpointSeconds'
+	// seconds with the clock polled every `checkpointSteps' steps
+	std::string 			checkpointPath;
+	unsigned long 			checkpointSteps;
+	double 				checkpointSeconds;
+	unsigned long 			stepsSinceCheckpoint;
+	Timer 				checkpointTimer;
+	// The best state so far is the current one with the changes in `bestJournal' undone,
+	// or, when the journal grows past the number of variables, the copy in `bestState'
+	StateVector 			bestState;
+	unsigned long 			bestConflicts;
+	std::vector<std::pair<naxos::NsIndex, int> > bestJournal;
+	bool 				bestJournalValid;
+	// For Iterated Local Search; the accepted local optimum is the current state with the changes in
+	// `iteratedJournal' undone, or, when the journal grows past the number of variables, the copy in `iteratedState'
+	StateVector 			iteratedState;
+	std::vector<std::pair<naxos::NsIndex, int> > iteratedJournal;
+	bool 				iteratedJournalValid;
+	unsigned long 			iteratedConflicts;
+	// The current perturbation strength, and the hashes of the last local optima met
+	unsigned long 			iteratedMoves;
+	ActiveWindow<StateHash> 	iteratedOptima;
+	// For Hill Climbing; the states (hash) met with the same number of conflicting constraints,
+	// kept as a member so that the storage it grows to is reused by the following solves
+	ActiveWindow<StateHash> 	previousStates;
+	// For Late Acceptance; the conflicts of the last `historyLength' steps, in a circular array
+	std::vector<unsigned long> 	lateHistory;
+	// The position of the running search when saving, or a restored checkpoint not yet resumed from
+	struct Checkpoint
+	{
+		unsigned int 		algorithm;
+		StateVector 		values;
+		std::vector<std::pair<naxos::NsIndex, int> > tabu;
+		unsigned long 		schedulerStep;
+		unsigned long 		stableStep;
+		std::vector<unsigned long> counters;
+		// The weights other than `1', each with the indices of the variables of its constraints
+		std::vector<std::pair<std::vector<naxos::NsIndex>, unsigned long> > weights;
+		// The penalized (variable, value) features with their penalties
+		std::vector<std::pair<std::pair<naxos::NsIndex, int>, unsigned long> > penalties;
+		// The accepted local optimum of Iterated Local Search, none when `iteratedConflicts' is NsUPLUS_INF
+		unsigned long 		iteratedConflicts;
+		unsigned long 		iteratedMoves;
+		StateVector 		iteratedState;
+		std::vector<StateHash> 	iteratedOptima;
+		// The steps the restart policy allowed the iteration in progress, checked against the policy resumed with
+		bool 			restartPolicy;
+		unsigned long 		restartLimit;
+		// The Late Acceptance history, none for the other algorithms
+		std::vector<unsigned long> lateHistory;
+	} 				checkpointData;
+	bool 				resumePending;
+	// Values the next search starts from, given by `startFrom()'
+	StateVector 			startState;
+	bool 				startPending;
+	// Whether the labeled variables hold the values of a search, finished or interrupted
+	bool 				assigned;
+
+
+	void initialize (void);
+	void reset (void);
+	bool isDiverse (void);
+	void restartHill (HillConfiguration*);
+	void importElite (HillConfiguration*);
+	void iterateHill (HillConfiguration*);
+	void perturb (unsigned long);
+
+	void solveHill (void);
+	void solveAnnealing (void);
+	void solveLateAcceptance (void);
+
+	// MD5 of the current solution, or of its canonical form when there is a canonicalizer
+	std::string hashSolution (void);
+	static StateHash hashAssignment (naxos::NsIndex, naxos::NsInt);
+	StateHash hashStep (naxos::NsIndex, naxos::NsInt);
+	void rehashState (void);
+
+	// The weight of a constraint of a violated list, shared by the constraints over the same variables
+	unsigned long& constraintWeight (const ConfVariables&);
+	void increaseWeights (void);
+	unsigned long penalty (naxos::NsIndex i, int value) const
+	{
+		const FeaturePenalties& 	features = penalties[i];
+		for ( FeaturePenalties::const_iterator it = features.begin() ; it != features.end() ; ++it )
+			if ( it->first == value ) return it->second;
+		return 0;
+	}
+	void penalize (naxos::NsIndex i, int value);
+	void resetPenalties (void);
+	void increasePenalties (void);
+	void countConflicts (const ConfConstraints&, bool added);
+	void rebuildConflicts (void);
+
+	void pushTabu (Assignment);
+	void popTabu (void);
+	void clearTabu (void);
+	bool isTabu (Assignment);
+	// Assigns a value other than the current one, drawn at random, evaluating only that move;
+	// Returns false, with nothing changed, if the move isn't allowed, otherwise the move is
+	// journaled, for `rejectRandomMove()' to take it back, or `acceptMove()' to keep it;
+	// With a zero tenure the moves aren't made tabu, as the list would have no bound
+	bool tryRandomMove (VariablePtr);
+	void rejectRandomMove (void);
+
+	void checkpointStep (unsigned long, unsigned long);
+	// Brings back the weights and penalties of a restored checkpoint, before the search is initialized
+	void resumeLearning (void);
+	void materializeBest (void);
+	void materializeIterated (void);
+
+public:
+
+	// Declared as public so that other classes can use the same instance to produce random numbers
+	MTRand_int32 	random;
+
+	// Reused by the heuristics on every step so that selecting doesn't allocate;
+	// The contents are only meaningful during a single select()
+	std::vector<VariablePtr> 	scratchVariables;
+
+
+	LsProblemManager (unsigned long tabuTenure_ = 1, unsigned long seed_ = 1) : varArray(NULL), canonicalizer(NULL), conf(NULL), initializer(NULL), constraintGraph(NULL), solutionCallback(NULL), trace(NULL),
+			enumerationMoves(0), minDistance(1), perturbPending(false), perturbMoves(0), distinctSolutions(0), rejectedSolutions(0), enumerationTime(0.0),
+			tabuTenure(tabuTenure_), tabuAssignments(tabuTenure), tabuSwaps(tabuTenure), swapMoves(false), weightIncrement(0), weightedConflicts(0),
+			cachedVariable(NULL), cachedVariableConflicts(0), penaltyLambda(0), currentPenalty(0), trackConflicts(false), conflictsTracked(false), seed(seed_), stream(NO_STREAM), currentHash(0), checkpointSteps(0), checkpointSeconds(0.0),
+			stepsSinceCheckpoint(0), bestConflicts(naxos::NsUPLUS_INF), bestJournalValid(false),
+			iteratedJournalValid(false), iteratedConflicts(naxos::NsUPLUS_INF), iteratedMoves(0), iteratedOptima(16), resumePending(false),
+			startPending(false), assigned(false), random(seed) { }
+	virtual ~LsProblemManager (void) {}
+
+	void label (naxos::NsIntVarArray& varArray_, Configuration* conf_);
+	void useInitializer (Initializer* initializer_) { initializer = initializer_; }
+	// Given before `label()', which copies it; It may be freed afterwards
+	void useConstraintGraph (const ConstraintGraph& graph) { constraintGraph = &graph; }
+	const CompactModel& model (void) const { return compact; }
+	// E.g. a TextSolutionWriter, BinarySolutionWriter or MappedSolutionWriter
+	void onSolution (SolutionCallback* solutionCallback_) { solutionCallback = solutionCallback_; }
+	void nextSolution (void);
+	// Forget the solutions found, so that the model can be solved again from scratch (e.g. with another seed)
+	void clearSolutions (void);
+	// Find the next solutions near the previous one, `moves' random moves away; The moves double while
+	// the solutions found are repeated or closer than `minDistance_' values to any of the last `window'
+	void enumerate (unsigned long moves, unsigned long minDistance_ = 1, unsigned long window = 16);
+	// Run on every solution before checking whether it was found before
+	void useCanonicalizer (SolutionCanonicalizer* canonicalizer_) { canonicalizer = canonicalizer_; }
+	// Draw the random numbers from stream `stream_' of the master seed `seed_', e.g. stream `i' for the `i'th
+	// worker of a parallel run, so that the run can be repeated with the same seed and number of workers
+	void randomStream (unsigned long seed_, unsigned long stream_) { seed = seed_; stream = stream_; random.seedStream( seed, stream ); }
+	// Sample the progress of every search into `trace_'; NULL stops it
+	void useTrace (TraceRecorder* trace_) { trace = trace_; }
+	// The next search starts from the given values (e.g. a recombined state) instead of initializing;
+	// The values of a search that was interrupted, by an exception from a heuristic, are dropped
+	void startFrom (const StateVector&);
+
+	bool tryAssignment (Assignment);
+	void commitAssignment (Assignment);
+	void revertToAssignment (Assignment);
+	void applyAssignment (Assignment);
+
+	// Journal the assignments from now on, so that `undoMove()' takes them all back by restoring what they
+	// changed instead of reassigning and recounting; `acceptMove()' keeps them and stops the journal
+	// NOTE: The tabu list isn't journaled; Naxos keeps the values and the violated constraints itself, and
+	// offers no way to restore them, so the undo still sets every changed variable back through `lsSet()',
+	// which costs naxos an evaluation of its constraints; Only the bookkeeping of this class is restored
+	// from the journal, so the gain over reassigning is limited to it
+	void markMove (void);
+	void undoMove (void);
+	void acceptMove (void) { moveJournal.recording = false; }
+
+	// For the swap neighbourhood; Exchanging the values of two variables, with `trySwap' undoing the exchange
+	// and leaving the conflicts in between in `swapConflicts'; It fails if the swap is tabu and doesn't
+	// improve the incumbent candidate solution, or if a value isn't in the domain of the other variable
+	bool trySwap (VariablePtr, VariablePtr, unsigned long& swapConflicts);
+	void commitSwap (VariablePtr, VariablePtr);
+	void applySwap (VariablePtr, VariablePtr);
+	void useSwapMoves (bool swapMoves_ = true) { swapMoves = swapMoves_; }
+
+	// The labeled variables
+	naxos::NsIntVarArray& labeled (void) { return *varArray; }
+	// The variables of `lsConflictingVars()', in no particular order, but indexable
+	const std::vector<VariablePtr>& conflictingVariables (void)
+	{
+		if ( !conflictsTracked ) rebuildConflicts();
+		return conflictVariables;
+	}
+	// Whether `conflictingVariables()' is kept up to date, rather than rebuilt on every call
+	bool tracksConflicts (void) const { return trackConflicts; }
+
+	// A value of the domain at random
+	naxos::NsInt randomValue (naxos::NsIntVar&);
+
+	// Copy the current values out, or move to the given values reassigning only those that differ
+	void captureState (StateVector&);
+	void restoreState (const StateVector&);
+
+	// Save checkpoints to `path' periodically while solving; zero `steps' and `seconds' stop them
+	void checkpointEvery (const std::string& path, unsigned long steps, double seconds = 0.0);
+	// Write the search state now, or read it back so that the next search continues from it; The state includes the
+	// constraint weights, the penalties, the accepted optimum of Iterated Local Search, the restart policy's limit and
+	// the Late Acceptance history, but not an elite pool, with which checkpoints are refused
+	void saveCheckpoint (const std::string& path);
+	void restoreCheckpoint (const std::string& path);
+	// The best state met since checkpoints were enabled, with its number of violated constraints
+	unsigned long bestAssignment (StateVector&);
+
+	// The objective minimized by the heuristics; the number of violated constraints
+	// or, when Constraint Weighting is in use, their total weight; Guided Local Search
+	// adds `penaltyLambda' times the penalties of the current assignments
+	unsigned long conflicts (void);
+	unsigned long conflicts (naxos::NsIntVar&);
+
+	std::ostream& solutionToString (std::ostream&);
+	std::ostream& configuration (std::ostream&);
+	std::ostream& statistics (std::ostream&);
+	// Bytes used by the compact model and the search buffers
+	std::ostream& memoryReport (std::ostream&);
+
+	void printTabu(void)
+	{
+		std::cerr << "\t\t\t\t\t\t\t\t\t\tTABU LIST: ";
+		for (ActiveWindow<Assignment>::iterator it = tabuAssignments.begin() ; it != tabuAssignments.end() ; it++)
+			std::cerr << "| " << it->first->lsIndex() << " - " << it->second << " ";
+		std::cerr << std::endl;
+	}
+};
+
+
+
+
+
+////////////////////////////////////// MaxConflictingVariable //////////////////////////////////////
+
+// Returns variable participating in the most violated constraints
+struct MaxConflictingVariable : public VariableHeuristic
+{
+	MaxConflictingVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		int 		maxViolations = 0;
+		std::vector<VariablePtr>& maxVariables = pm.scratchVariables;
+		maxVariables.clear();
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		for ( ConfVariables::const_iterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		{
+			int currentViolations = pm.conflicts( *(*it) );
+			if ( currentViolations > maxViolations )
+			{
+				maxViolations = currentViolations;
+				maxVariables.clear();
+			}
+			if ( currentViolations == maxViolations ) maxVariables.push_back( *it );
+		}
+
+		// Tie break is random
+		return maxVariables[ pm.random( maxVariables.size() ) ];
+	}
+};
+
+
+////////////////////////////////////// MinConflictingVariable //////////////////////////////////////
+
+// Returns variable participating in the least violated constraints
+struct MinConflictingVariable : public VariableHeuristic
+{
+	MinConflictingVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		int 		minViolations = pm.conflicts( *(*conflictSet.begin()) );
+		std::vector<VariablePtr>& minVariables = pm.scratchVariables;
+		minVariables.clear();
+		for ( ConfVariables::const_iterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		{
+			int currentViolations = pm.conflicts( *(*it) );
+			if ( currentViolations < minViolations )
+			{
+				minViolations = currentViolations;
+				minVariables.clear();
+			}
+			if ( currentViolations == minViolations ) minVariables.push_back( *it );
+		}
+
+		// Tie break is random
+		return minVariables[ pm.random( minVariables.size() ) ];
+	}
+};
+
+
+////////////////////////////////////// FirstVariable //////////////////////////////////////
+
+// Returns the first variable
+struct FirstVariable : public VariableHeuristic
+{
+	FirstVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		const ConfVariables& conflictSet = pm.lsConflictingVars();
+		return *conflictSet.begin();
+	}
+};
+
+
+////////////////////////////////////// BiggestDomainVariable //////////////////////////////////////
+
+// Returns variable with the biggest domain
+struct BiggestDomainVariable : public VariableHeuristic
+{
+	BiggestDomainVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		unsigned int 	biggestDomain = 0;
+		std::vector<VariablePtr>& biggestVariables = pm.scratchVariables;
+		biggestVariables.clear();
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		for ( ConfVariables::const_iterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		{
+			unsigned int currentSize = (*it)->size();
+			if ( currentSize > biggestDomain )
+			{
+				biggestDomain = currentSize;
+				biggestVariables.clear();
+			}
+			if ( currentSize == biggestDomain ) biggestVariables.push_back( *it );
+		}
+
+		// Tie break is random
+		return biggestVariables[ pm.random( biggestVariables.size() ) ];
+	}
+};
+
+
+////////////////////////////////////// SmallestDomainVariable //////////////////////////////////////
+
+// Returns variable with the smallest domain
+struct SmallestDomainVariable : public VariableHeuristic
+{
+	SmallestDomainVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		unsigned int 	smallestDomain = (*conflictSet.begin())->size();
+		std::vector<VariablePtr>& smallestVariables = pm.scratchVariables;
+		smallestVariables.clear();
+		for ( ConfVariables::const_iterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		{
+			unsigned int currentSize = (*it)->size();
+			if ( currentSize < smallestDomain )
+			{
+				smallestDomain = currentSize;
+				smallestVariables.clear();
+			}
+			if ( currentSize == smallestDomain ) smallestVariables.push_back( *it );
+		}
+
+		// Tie break is random
+		return smallestVariables[ pm.random( smallestVariables.size() ) ];
+	}
+};
+
+
+////////////////////////////////////// RandomVariable //////////////////////////////////////
+
+// Returns a variable at random
+struct RandomVariable : public VariableHeuristic
+{
+	RandomVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		if ( pm.tracksConflicts() )
+		{
+			const std::vector<VariablePtr>& 	conflictSet = pm.conflictingVariables();
+			return conflictSet[ pm.random( conflictSet.size() ) ];
+		}
+
+		// Walking the list is cheaper than rebuilding the set for a single draw
+		const ConfVariables& 	conflictList = pm.lsConflictingVars();
+		ConfVariables::const_iterator 	it = conflictList.begin();
+		for ( unsigned long selection = pm.random( conflictList.size() ) ; selection != 0 ; selection-- ) it++;
+
+		return *it;
+	}
+
+	bool drawsConflicts (void) { return true; }
+};
+
+
+
+
+////////////////////////////////////// SampledConflictingVariable //////////////////////////////////////
+
+// Returns the variable participating in the most violated constraints among a random
+// sample of the conflicting variables; Cheaper than MaxConflictingVariable on huge conflict sets
+struct SampledConflictingVariable : public VariableHeuristic
+{
+
+private:
+
+	// Zero adapts the sample to the square root of the conflict set size
+	unsigned long 			sampleSize;
+	std::vector<unsigned long> 	positions;
+	std::vector<VariablePtr> 	maxVariables;
+
+	void consider (VariablePtr variable, unsigned long& maxViolations)
+	{
+		unsigned long currentViolations = pm.conflicts( *variable );
+		if ( currentViolations > maxViolations )
+		{
+			maxViolations = currentViolations;
+			maxVariables.clear();
+		}
+		if ( currentViolations == maxViolations ) maxVariables.push_back( variable );
+	}
+
+public:
+
+	SampledConflictingVariable (LsProblemManager& pm_, unsigned long sampleSize_ = 0) :
+			VariableHeuristic(pm_), sampleSize(sampleSize_) {}
+
+	VariablePtr select (void)
+	{
+		unsigned long 	maxViolations = 0;
+		maxVariables.clear();
+
+		if ( pm.tracksConflicts() )
+		{
+			const std::vector<VariablePtr>& 	conflictSet = pm.conflictingVariables();
+			samplePositions( conflictSet.size(), sampleSize, positions );
+			for ( std::vector<unsigned long>::iterator p = positions.begin() ; p != positions.end() ; p++ )
+				consider( conflictSet[*p], maxViolations );
+		}
+		else
+		{
+			// Wrapped in a heuristic that doesn't forward `drawsConflicts()'; the sorted positions walk the list once
+			const ConfVariables& 	conflictList = pm.lsConflictingVars();
+			samplePositions( conflictList.size(), sampleSize, positions );
+			ConfVariables::const_iterator 	it = conflictList.begin();
+			unsigned long 			position = 0;
+			for ( std::vector<unsigned long>::iterator p = positions.begin() ; p != positions.end() ; p++ )
+			{
+				for ( ; position < *p ; position++ ) it++;
+				consider( *it, maxViolations );
+			}
+		}
+
+		// Tie break is random
+		return maxVariables[ pm.random( maxVariables.size() ) ];
+	}
+
+	bool drawsConflicts (void) { return true; }
+
+	std::ostream& configuration (std::ostream&);
+};
+
+
+
+
+////////////////////////////////////// MinConflictingValue //////////////////////////////////////
+
+// Select value for selected variable that minimizes violated constraints
+struct MinConflictingValue : public ValueHeuristic
+{
+	MinConflictingValue (LsProblemManager& pm_) : ValueHeuristic(pm_) { }
+
+	naxos::NsInt select (naxos::NsIntVar& variable)
+	{
+		using namespace naxos;
+
+		const CompactModel& 	model = pm.model();
+		NsIndex 		i = variable.lsIndex();
 		NsInt 	confValue = variable.lsValue();
-		NsInt 	selectedValue = 0;
-		for ( NsInt currentValue = variable.min() ; currentValue <= variable.max() ; currentValue = variable.next(currentValue) )
+		NsInt 	minConflicts = pm.conflicts();
+		NsInt 	minConfValue = confValue;
+		for ( unsigned long k = 0, size = model.domains[i].size ; k < size ; k++ )
+		{
+			NsInt 	currentValue = model.domainValue( i, k );
+
+			// Skip assignment if it is the same as the current one
+			if ( currentValue == confValue ) continue;
+
+			// Try to assign the current value; it will fail if the assignment isn't allowed
+			// On failure skip the current value and try the next one
+			if ( !pm.tryAssignment( std::make_pair(&variable, currentValue) ) ) continue;
+
+			NsInt currentConflicts = pm.conflicts();
+			if ( currentConflicts < minConflicts )
+			{
+				// Update best assignment
+				minConflicts = currentConflicts;
+				minConfValue = currentValue;
+			}
+		}
+
+		// Commit final assignment
+		pm.commitAssignment( std::make_pair(&variable, minConfValue) );
+
+		return minConfValue;
+	}
+};
+
+
+////////////////////////////////////// RandomValue //////////////////////////////////////
+
+// Select value at random; The value at a random position of the domain, or the first one after it
+// that isn't the current one and whose assignment is allowed
+struct RandomValue : public ValueHeuristic
+{
+	RandomValue(LsProblemManager& pm_) : ValueHeuristic(pm_) {}
+
+	naxos::NsInt select (naxos::NsIntVar& variable)
+	{
+		using namespace naxos;
+
+		const CompactModel& 	model = pm.model();
+		NsIndex 		i = variable.lsIndex();
+		unsigned long 		size = model.domains[i].size;
+		unsigned long 		position = pm.random( size );
+		NsInt 	confValue = variable.lsValue();
+		// Kept when no value is allowed
+		NsInt 	selectedValue = model.domainValue( i, position );
+		for ( unsigned long k = 0 ; k < size ; k++, position = ( position + 1 == size ) ? 0 : position + 1 )
+		{
+			NsInt 	currentValue = model.domainValue( i, position );
+
+			// Skip assignment if it is the same as the current one
+			if ( currentValue == confValue ) continue;
+
+			// Try to assign the current value; it will fail if the assignment isn't allowed
+			// On failure skip the current value and try the next one
+			if ( !pm.tryAssignment( std::make_pair(&variable, currentValue) ) ) continue;
+
+			selectedValue = currentValue;
+			break;
+		}
+		// Commit final assignment
+		pm.commitAssignment( std::make_pair(&variable, selectedValue) );
+
+		return selectedValue;
+	}
+};
+
+
+
+
+////////////////////////////////////// MinConflictingSwap //////////////////////////////////////
+
+// Swaps the value of the selected variable with the one of the variable minimizing the violated
+// constraints; Tries every other labeled variable, or `sampleSize' of them at random if not zero
+// NOTE: For permutations, together with PermutationInitializer and `useSwapMoves()'
+struct MinConflictingSwap : public ValueHeuristic
+{
+
+private:
+
+	unsigned long 	sampleSize;
+
+public:
+
+	MinConflictingSwap (LsProblemManager& pm_, unsigned long sampleSize_ = 0) : ValueHeuristic(pm_), sampleSize(sampleSize_) {}
+
+	naxos::NsInt select (naxos::NsIntVar& variable)
+	{
+		using namespace naxos;
+
+		NsIntVarArray& 			variables = pm.labeled();
+		NsIndex 			size = variables.size();
+		unsigned long 			minConflicts = NsUPLUS_INF;
+		std::vector<VariablePtr>& 	minPartners = pm.scratchVariables;
+		minPartners.clear();
+
+		NsIndex tries = ( sampleSize == 0 || sampleSize > size ) ? size : sampleSize;
+		for ( NsIndex t = 0 ; t < tries ; t++ )
+		{
+			VariablePtr 	partner = &variables[ ( tries == size ) ? t : pm.random( size ) ];
+			unsigned long 	swapConflicts;
+			// Skip swaps changing nothing, and the swaps not allowed
+			if ( partner == &variable || partner->lsValue() == variable.lsValue() ) continue;
+			if ( !pm.trySwap( &variable, partner, swapConflicts ) ) continue;
+
+			if ( swapConflicts < minConflicts )
+			{
+				minConflicts = swapConflicts;
+				minPartners.clear();
+			}
+			if ( swapConflicts == minConflicts ) minPartners.push_back( partner );
+		}
+
+		// Tie break is random
+		if ( !minPartners.empty() ) pm.commitSwap( &variable, minPartners[ pm.random( minPartners.size() ) ] );
+
+		return variable.lsValue();
+	}
+};
+
+
+////////////////////////////////////// RandomSwap //////////////////////////////////////
+
+// Swaps the value of the selected variable with the one of a variable at random
+struct RandomSwap : public ValueHeuristic
+{
+	RandomSwap (LsProblemManager& pm_) : ValueHeuristic(pm_) {}
+
+	naxos::NsInt select (naxos::NsIntVar& variable)
+	{
+		using namespace naxos;
+
+		NsIntVarArray& 	variables = pm.labeled();
+		NsIndex 	size = variables.size();
+		// A few attempts to find a partner that changes something and isn't tabu
+		for ( NsIndex attempt = 0 ; attempt < size ; attempt++ )
+		{
+			VariablePtr 	partner = &variables[ pm.random( size ) ];
+			unsigned long 	swapConflicts;
+			if ( partner == &variable || partner->lsValue() == variable.lsValue() ) continue;
+			if ( !pm.trySwap( &variable, partner, swapConflicts ) ) continue;
+
+			pm.commitSwap( &variable, partner );
+			break;
+		}
+
+		return variable.lsValue();
+	}
+};
+
+
+
+
+////////////////////////////////////// BestImprovementVariable //////////////////////////////////////
+
+// Returns the variable that causes the best improvement over the conflicting constraints
+// NOTE: Can only be used with BestImprovementValue as a ValueHeuristic
+struct BestImprovementVariable : public VariableHeuristic
+{
+
+protected:
+
+	naxos::NsInt 			bestValue;
+	int 				minConflicts;
+	std::vector<VariablePtr> 	bestVariables;
+	ValueVector 			bestValues;
+
+	// Finds the best value of `variable' and keeps the variable if it is among the best so far
+	void evaluate (naxos::NsIntVar& variable)
+	{
+		using namespace naxos;
+
+		MinConflictingValue selectValue( pm );
+		pm.markMove();
+		NsInt 	selectedValue = selectValue.select( variable );
+		NsInt 	currentConflicts = pm.conflicts();
+
+		if ( currentConflicts < minConflicts )
 		{
-			selectedValue = currentValue;
+			minConflicts = currentConflicts;
+			bestVariables.clear();
+			bestValues.clear();
+		}
+		if ( currentConflicts == minConflicts )
+		{
+			bestVariables.push_back( &variable );
+			bestValues.push_back( selectedValue );
+		}
 
-			// Skip assignment if it is the same as the current one
-			if ( currentValue == confValue ) continue;
+		// Every value tried is taken back at once
+		pm.undoMove();
+	}
 
-			// Try to assign the current value; it will fail if the assignment isn't allowed
-			// On failure skip the current value and try the next one
-			if ( !pm.tryAssignment( std::make_pair(&variable, currentValue) ) ) continue;
+	VariablePtr bestVariable (void)
+	{
+		// Tie break is random
+		unsigned int selection = pm.random( bestVariables.size() );
+		bestValue = bestValues[ selection ];
+		return bestVariables[ selection ];
+	}
+
+public:
+
+	BestImprovementVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
+
+	VariablePtr select (void)
+	{
+		minConflicts = pm.conflicts();
+		bestVariables.clear();
+		bestValues.clear();
+
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		for ( ConfVariables::const_iterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+			evaluate( *(*it) );
+
+		return bestVariable();
+	}
+
+	friend struct BestImprovementValue;
+};
+
+
+////////////////////////////////////// SampledBestImprovementVariable //////////////////////////////////////
+
+// Like BestImprovementVariable, but only evaluates a random sample of the conflicting variables
+// NOTE: Can only be used with BestImprovementValue as a ValueHeuristic
+struct SampledBestImprovementVariable : public BestImprovementVariable
+{
+
+private:
+
+	// Zero adapts the sample to the square root of the conflict set size
+	unsigned long 			sampleSize;
+	std::vector<unsigned long> 	positions;
+
+public:
+
+	SampledBestImprovementVariable (LsProblemManager& pm_, unsigned long sampleSize_ = 0) :
+			BestImprovementVariable(pm_), sampleSize(sampleSize_) {}
+
+	VariablePtr select (void)
+	{
+		minConflicts = pm.conflicts();
+		bestVariables.clear();
+		bestValues.clear();
+
+		const ConfVariables& 	conflictSet = pm.lsConflictingVars();
+		samplePositions( conflictSet.size(), sampleSize, positions );
+
+		ConfVariables::const_iterator it = conflictSet.begin();
+		unsigned long position = 0;
+		for ( std::vector<unsigned long>::iterator p = positions.begin() ; p != positions.end() ; p++ )
+		{
+			for ( ; position < *p ; position++ ) it++;
+			evaluate( *(*it) );
+		}
+
+		return bestVariable();
+	}
+
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// BestImprovementValue //////////////////////////////////////
+
+struct BestImprovementValue : public ValueHeuristic
+{
+
+private:
+
+	BestImprovementVariable& variableSelect;
+
+public:
+
+	BestImprovementValue(LsProblemManager& pm_, BestImprovementVariable& variableSelect_) : ValueHeuristic(pm_), variableSelect(variableSelect_) {}
+
+	naxos::NsInt select (naxos::NsIntVar& variable)
+	{
+		// Commit final assignment
+		pm.commitAssignment( std::make_pair(&variable, variableSelect.bestValue) );
+
+		return variableSelect.bestValue;
+	}
+};
+
+
+
+
+////////////////////////////////////// RandomInitializer //////////////////////////////////////
+
+// Assigns a value at random to every variable; the default
+struct RandomInitializer : public Initializer
+{
+	RandomInitializer (LsProblemManager& pm_) : Initializer(pm_) {}
+
+	void assign (naxos::NsIntVarArray& variables)
+	{
+		for ( naxos::NsIndex i = 0, size = variables.size() ; i < size ; i++ ) variables[i].lsSet( pm.randomValue(variables[i]) );
+	}
+
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// PermutationInitializer //////////////////////////////////////
+
+// Assigns distinct values at random, from the domain of the first variable, which must have
+// at least as many values as there are variables; The default with `useSwapMoves()'
+struct PermutationInitializer : public Initializer
+{
+
+private:
+
+	ValueVector 	values;
+
+public:
+
+	PermutationInitializer (LsProblemManager& pm_) : Initializer(pm_) {}
+
+	void assign (naxos::NsIntVarArray&);
+
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// GreedyInitializer //////////////////////////////////////
+
+// Assigns the variables one by one, each to the value violating the fewest constraints with
+// the variables already assigned; Tries `maxTries' values at random, or the whole domain if zero;
+// By default every value tried is set and its violated constraints asked from naxos, which costs
+// a constraint evaluation per value; When the constraints are described by difference groups,
+// or as differences between neighbours in the constraint graph, the conflicts of every value are
+// instead counted from the variables already assigned, and only these constraints are considered
+struct GreedyInitializer : public Initializer
+{
+
+public:
+
+	enum Order {INDEX_ORDER, RANDOM_ORDER, DEGREE_ORDER};
+
+private:
+
+	Order 				order;
+	unsigned long 			maxTries;
+	std::vector<naxos::NsIndex> 	sequence;
+	const DifferenceGroups* 	groups;
+	bool 				differentNeighbours;
+
+	// How many assigned members of every group have every shifted value; The values of group `g' are
+	// counted from groupMin[g], in groupCounts[ groupOffsets[g] ... groupOffsets[g+1] )
+	std::vector<naxos::NsInt> 		groupMin;
+	std::vector<unsigned long> 		groupOffsets;
+	std::vector<unsigned long> 		groupCounts;
+	// The groups of variable `i', with its shift in each, are memberships[ membershipOffsets[i] ... membershipOffsets[i+1] )
+	std::vector<unsigned long> 		membershipOffsets;
+	std::vector<std::pair<naxos::NsIndex, naxos::NsInt> > 	memberships;
+	std::vector<bool> 			assigned;
+	// How many assigned neighbours have every value of the variable being assigned, counted from its minimum
+	std::vector<unsigned long> 		neighbourCounts;
+
+	void arrange (naxos::NsIndex);
+	void prepareCounts (naxos::NsIntVarArray&);
+	unsigned long countConflicts (naxos::NsIndex, naxos::NsInt, naxos::NsInt);
+	void assignProbing (naxos::NsIntVarArray&);
+	void assignCounting (naxos::NsIntVarArray&);
+
+public:
+
+	// DEGREE_ORDER needs `graph_', or a constraint graph given to the problem manager
+	GreedyInitializer (LsProblemManager& pm_, Order order_ = RANDOM_ORDER, unsigned long maxTries_ = 0, const ConstraintGraph* graph_ = NULL) :
+			Initializer(pm_, graph_), order(order_), maxTries(maxTries_), groups(NULL), differentNeighbours(false) {}
+
+	// Count the conflicts of the groups' variables instead of asking naxos
+	void useDifferenceGroups (const DifferenceGroups* groups_) { groups = groups_; }
+	// Neighbours in the constraint graph must take different values, as in graph coloring
+	void useDifferentNeighbours (bool differentNeighbours_ = true) { differentNeighbours = differentNeighbours_; }
 
-			if ( selection-- == 0 ) break;
+	void assign (naxos::NsIntVarArray&);
 
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// DsaturInitializer //////////////////////////////////////
+
+// Graph coloring; Assigns the most saturated variable (most distinct values among its neighbours)
+// first, ties broken by degree, to its smallest value unused by its neighbours, or the least used
+struct DsaturInitializer : public Initializer
+{
+
+private:
+
+	// The distinct values of the neighbours of variable `j', each with how many neighbours have it,
+	// unordered in seen[ seenOffsets[j] ... seenOffsets[j] + saturation[j] ); At most its degree
+	std::vector<naxos::NsIndex> 			seenOffsets;
+	std::vector<std::pair<int, naxos::NsIndex> > 	seen;
+	std::vector<naxos::NsIndex> 			saturation;
+	std::vector<bool> 				assigned;
+	// The values around the variable being assigned, sorted
+	std::vector<std::pair<int, naxos::NsIndex> > 	around;
+
+public:
+
+	DsaturInitializer (LsProblemManager& pm_, const ConstraintGraph& graph_) : Initializer(pm_, &graph_) {}
+	// Uses the constraint graph given to the problem manager
+	DsaturInitializer (LsProblemManager& pm_) : Initializer(pm_) {}
+
+	void assign (naxos::NsIntVarArray&);
+
+	std::ostream& configuration (std::ostream&);
+};
+
+
+
+
+////////////////////////////////////// LogarithmicScheduler //////////////////////////////////////
+
+struct LogarithmicScheduler : public TemperatureScheduler
+{
+
+private:
+
+	unsigned int d;
+
+public:
+
+	LogarithmicScheduler(LsProblemManager& pm_, unsigned long stableSteps_, int d_) :
+			TemperatureScheduler(pm_, stableSteps_), d(d_) {}
+
+	double operator[] (unsigned long step)
+	{
+		return (100000 * d / log ( step ));
+	}
+	
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// GeometricScheduler //////////////////////////////////////
+
+struct GeometricScheduler : public TemperatureScheduler
+{
+
+private:
+
+	double r;
+	double previous;
+	unsigned long previousStep;
+
+public:
+
+	GeometricScheduler(LsProblemManager& pm_, unsigned long stableSteps_, double r_) :
+			TemperatureScheduler(pm_, stableSteps_), r(r_), previous(100000.0), previousStep(0) {}
+
+	double operator[] (unsigned long step)
+	{
+		if ( step != previousStep )
+		{
+			previous = r * previous;
+			previousStep = step;
+		}
+		return previous;
+	}
+
+	void resume (unsigned long step)
+	{
+		previous = 100000.0 * pow( r, static_cast<double>(step) );
+		previousStep = step;
+	}
+	
+	std::ostream& configuration (std::ostream&);
+};
+
+
+
+
+////////////////////////////////////// FixedRestartPolicy //////////////////////////////////////
+
+// Every iteration takes the same number of steps
+struct FixedRestartPolicy : public RestartPolicy
+{
+	FixedRestartPolicy(LsProblemManager& pm_, unsigned long unitSteps_) : RestartPolicy(pm_, unitSteps_) {}
+
+	unsigned long operator[] (unsigned long)
+	{
+		return unitSteps;
+	}
+
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// GeometricRestartPolicy //////////////////////////////////////
+
+// Every iteration takes `factor' times the steps of the previous one
+struct GeometricRestartPolicy : public RestartPolicy
+{
+
+private:
+
+	double factor;
+
+public:
+
+	GeometricRestartPolicy(LsProblemManager& pm_, unsigned long unitSteps_, double factor_) :
+			RestartPolicy(pm_, unitSteps_), factor(factor_) {}
+
+	unsigned long operator[] (unsigned long restart)
+	{
+		double steps = unitSteps * pow( factor, static_cast<double>(restart) );
+		return ( steps >= naxos::NsUPLUS_INF ) ? naxos::NsUPLUS_INF : static_cast<unsigned long>(steps);
+	}
+
+	std::ostream& configuration (std::ostream&);
+};
+
+////////////////////////////////////// LubyRestartPolicy //////////////////////////////////////
+
+// Iterations take `unitSteps' times the terms of the Luby sequence (1 1 2 1 1 2 4 1 1 2 ...)
+struct LubyRestartPolicy : public RestartPolicy
+{
+	LubyRestartPolicy(LsProblemManager& pm_, unsigned long unitSteps_) : RestartPolicy(pm_, unitSteps_) {}
+
+	unsigned long operator[] (unsigned long restart)
+	{
+		// Find the finite subsequence containing the term, then its position in it
+		unsigned long size, sequence;
+		for ( size = 1, sequence = 0 ; size < restart + 1 ; size = 2 * size + 1, sequence++ ) ;
+		while ( size - 1 != restart )
+		{
+			size = (size - 1) >> 1;
+			sequence--;
+			restart = restart % size;
+		}
+
+		return unitSteps * (1UL << sequence);
+	}
+
+	std::ostream& configuration (std::ostream&);
+};
+
+
+
+
+///////////////// Inline for speed, must therefore reside in header file /////////////////
+
+inline void LsProblemManager::initialize (void)
+{
+	using namespace naxos;
+
+	NsIntVarArray& 	variables = *varArray;
+
+	if ( resumePending )
+	{
+		// Continue from a restored checkpoint
+		for ( NsIndex i = 0, size = variables.size() ; i < size ; i++ ) variables[i].lsSet( checkpointData.values[i] );
+	}
+	else if ( startPending )
+	{
+		for ( NsIndex i = 0, size = variables.size() ; i < size ; i++ ) variables[i].lsSet( startState[i] );
+		startPending = false;
+	}
+	else if ( perturbPending )
+	{
+		// Continue from the previous solution, still assigned
+		perturb( perturbMoves );
+		perturbPending = false;
+	}
+	else if ( initializer != NULL )
+	{
+		initializer->assign( variables );
+	}
+	else if ( swapMoves )
+	{
+		PermutationInitializer permutation( *this );
+		permutation.assign( variables );
+	}
+	else
+	{
+		for ( NsIndex i = 0, size = variables.size() ; i < size ; i++ )
+		{
+			//std::cerr << "TRYING TO LSSET " << i << std::endl;
+			variables[i].lsSet( randomValue(variables[i]) );
 		}
-		// Commit final assignment
-		pm.commitAssignment( std::make_pair(&variable, selectedValue) );
-
-		return selectedValue;
 	}
-};
-
-
 
+	clearTabu();
+	tabuSwaps.clear();
+	if ( resumePending )
+		for ( std::vector<std::pair<NsIndex, int> >::iterator it = checkpointData.tabu.begin() ; it != checkpointData.tabu.end() ; it++ )
+			pushTabu( std::make_pair(&variables[it->first], it->second) );
+
+	// Every variable has changed; compute the values, the state hash and the weighted conflicts from scratch
+	for ( NsIndex i = 0, size = variables.size() ; i < size ; i++ ) compact.values[i] = static_cast<int>( variables[i].lsValue() );
+	rehashState();
+	cachedVariable = NULL;
+	if ( weightIncrement != 0 )
+	{
+		const ConfConstraints& violatedList = lsViolatedConstraints();
+		weightedConflicts = 0;
+		for ( ConfConstraints::const_iterator it = violatedList.begin() ; it != violatedList.end() ; it++ )
+			weightedConflicts += constraintWeight( *it );
+	}
+	currentPenalty = 0;
+	if ( penaltyLambda != 0 )
+		for ( NsIndex i = 0, size = variables.size() ; i < size ; i++ ) currentPenalty += penalty( i, compact.values[i] );
+	conflictsTracked = false;
+	assigned = true;
+}
 
-////////////////////////////////////// BestImprovementVariable //////////////////////////////////////
 
-// Returns the variable that causes the best improvement over the conflicting constraints
-// NOTE: Can only be used with BestImprovementValue as a ValueHeuristic
-struct BestImprovementVariable : public VariableHeuristic
+inline void LsProblemManager::reset (void)
 {
+	// Every variable will change; the journal can't reach the best state anymore
+	if ( bestJournalValid ) materializeBest();
 
-private:
-
-	naxos::NsInt bestValue;
+	for ( naxos::NsIndex i = 0, size = varArray->size() ; i < size ; i++ ) (*varArray)[i].lsUnset();
 
-public:
+	cachedVariable = NULL;
+	weightedConflicts = 0;
+	currentPenalty = 0;
+	currentHash = 0;
+	conflictsTracked = false;
+	moveJournal.recording = false;
+	assigned = false;
+}
 
-	BestImprovementVariable (LsProblemManager& pm_) : VariableHeuristic(pm_) {}
 
-	VariablePtr select (void)
+inline void LsProblemManager::countConflicts (const ConfConstraints& violatedList, bool added)
+{
+	naxos::NsIndex 	size = conflictCounts.size();
+	for ( ConfConstraints::const_iterator it = violatedList.begin() ; it != violatedList.end() ; it++ )
 	{
-		using namespace naxos;
-
-		int 				minConflicts = pm.lsViolatedConstraints().size();
-		ConfVariables 		conflictSet = pm.lsConflictingVars();
-		ItVector 			bestIts;
-		ValueVector 		bestValues;
-		MinConflictingValue selectValue( pm );
-		for ( ConfVarsIterator it = conflictSet.begin() ; it != conflictSet.end() ; it++ )
+		for ( ConfVariables::const_iterator v = it->begin() ; v != it->end() ; v++ )
 		{
-			NsIntVar& variable = *(*it);
-			NsInt 	currentValue = variable.lsValue();
-			NsInt 	selectedValue = selectValue.select( variable );
-			NsInt 	currentConflicts = pm.lsViolatedConstraints().size();
+			// Intermediate variables of the constraints aren't labeled
+			naxos::NsIndex 	i = (*v)->lsIndex();
+			if ( i >= size || &(*varArray)[i] != *v ) continue;
 
-			if ( currentConflicts < minConflicts )
+			if ( moveJournal.recording ) moveJournal.counts.push_back( std::make_pair(i, added) );
+			if ( added )
 			{
-				minConflicts = currentConflicts;
-				bestIts.clear();
-				bestValues.clear();
+				if ( conflictCounts[i]++ != 0 ) continue;
+				conflictPositions[i] = conflictVariables.size();
+				conflictVariables.push_back( *v );
 			}
-			if ( currentConflicts == minConflicts )
+			else if ( --conflictCounts[i] == 0 )
 			{
-				bestIts.push_back( it );
-				bestValues.push_back( selectedValue );
+				// The last variable takes the place of the removed one
+				VariablePtr 	last = conflictVariables.back();
+				conflictVariables[ conflictPositions[i] ] = last;
+				conflictPositions[ last->lsIndex() ] = conflictPositions[i];
+				conflictVariables.pop_back();
 			}
-
-			// Don't call `commitAssignment' instead; We don't want to update the tabu status
-			variable.lsUnset();
-			variable.lsSet( currentValue );
 		}
-
-		// Tie break is random
-		unsigned int selection = pm.random( bestIts.size() );
-		bestValue = bestValues[ selection ];
-		return *bestIts[ selection ];
 	}
+}
 
-	friend struct BestImprovementValue;
-};
-
-////////////////////////////////////// BestImprovementValue //////////////////////////////////////
 
-struct BestImprovementValue : public ValueHeuristic
+inline void LsProblemManager::rebuildConflicts (void)
 {
+	naxos::NsIndex 	size = varArray->size();
+	if ( conflictCounts.size() != size )
+	{
+		conflictCounts.assign( size, 0 );
+		conflictPositions.resize( size );
+	}
+	// Only the variables of the previous set may have non-zero counts
+	for ( std::vector<VariablePtr>::iterator it = conflictVariables.begin() ; it != conflictVariables.end() ; it++ )
+		conflictCounts[ (*it)->lsIndex() ] = 0;
+	conflictVariables.clear();
 
-private:
+	countConflicts( lsViolatedConstraints(), true );
+	conflictsTracked = trackConflicts;
+}
 
-	BestImprovementVariable& variableSelect;
 
-public:
+inline unsigned long ConstraintIndex::hash (const std::vector<naxos::NsIndex>& indices)
+{
+	unsigned long 	key = 2166136261UL;
+	for ( std::vector<naxos::NsIndex>::const_iterator it = indices.begin() ; it != indices.end() ; it++ )
+		key = (key ^ *it) * 16777619UL;
 
-	BestImprovementValue(LsProblemManager& pm_, BestImprovementVariable& variableSelect_) : ValueHeuristic(pm_), variableSelect(variableSelect_) {}
+	return key ^ (key >> 29);
+}
 
-	naxos::NsInt select (naxos::NsIntVar& variable)
+
+inline unsigned long ConstraintIndex::bucket (const std::vector<naxos::NsIndex>& indices, unsigned long key) const
+{
+	unsigned long 	mask = buckets.size() - 1;
+	for ( unsigned long b = key & mask ; ; b = (b + 1) & mask )
 	{
-		// Commit final assignment
-		pm.commitAssignment( std::make_pair(&variable, variableSelect.bestValue) );
+		if ( buckets[b] == 0 ) return b;
 
-		return variableSelect.bestValue;
+		unsigned long 	c = buckets[b] - 1;
+		if ( hashes[c] == key && offsets[c + 1] - offsets[c] == indices.size()
+				&& std::equal( indices.begin(), indices.end(), members.begin() + offsets[c] ) )
+			return b;
 	}
-};
+}
+
+
+inline unsigned long ConstraintIndex::id (const ConfVariables& constraint)
+{
+	lookup.clear();
+	for ( ConfVariables::const_iterator it = constraint.begin() ; it != constraint.end() ; it++ )
+		lookup.push_back( (*it)->lsIndex() );
 
+	return id( lookup );
+}
 
 
+inline unsigned long ConstraintIndex::id (const std::vector<naxos::NsIndex>& indices)
+{
+	unsigned long 	key = hash( indices );
+	unsigned long 	b = bucket( indices, key );
+	if ( buckets[b] == 0 ) return insert( b, indices, key );
 
-////////////////////////////////////// LogarithmicScheduler //////////////////////////////////////
+	return buckets[b] - 1;
+}
 
-struct LogarithmicScheduler : public TemperatureScheduler
+
+inline bool ConstraintIndex::firstInWalk (unsigned long id)
 {
+	if ( lastWalk[id] == walk ) return false;
+	lastWalk[id] = walk;
 
-private:
+	return true;
+}
 
-	unsigned int d;
 
-public:
+inline unsigned long& LsProblemManager::constraintWeight (const ConfVariables& constraint)
+{
+	unsigned long 	id = constraintIndex.id( constraint );
+	// Constraints not met since the weights were reset weigh `1'
+	if ( id >= constraintWeights.size() ) constraintWeights.resize( id + 1, 1 );
 
-	LogarithmicScheduler(LsProblemManager& pm_, unsigned long stableSteps_, int d_) :
-			TemperatureScheduler(pm_, stableSteps_), d(d_) {}
+	return constraintWeights[id];
+}
 
-	double operator[] (unsigned long step)
+
+inline void VariableHeuristic::samplePositions (unsigned long setSize, unsigned long sampleSize, std::vector<unsigned long>& positions)
+{
+	if ( sampleSize == 0 ) sampleSize = static_cast<unsigned long>( std::ceil( std::sqrt( static_cast<double>(setSize) ) ) );
+
+	positions.clear();
+	// The sample is the whole set
+	if ( sampleSize >= setSize )
 	{
-		return (100000 * d / log ( step ));
+		for ( unsigned long i = 0 ; i < setSize ; i++ ) positions.push_back( i );
+		return;
 	}
-	
-	std::ostream& configuration (std::ostream&);
-};
 
-////////////////////////////////////// GeometricScheduler //////////////////////////////////////
+	// Draw with replacement and drop the duplicates; cheaper than a selection pass over the set
+	for ( unsigned long i = 0 ; i < sampleSize ; i++ ) positions.push_back( pm.random( setSize ) );
+	std::sort( positions.begin(), positions.end() );
+	positions.erase( std::unique( positions.begin(), positions.end() ), positions.end() );
+}
 
-struct GeometricScheduler : public TemperatureScheduler
+
+inline bool Initializer::hasGraph (void)
 {
+	return graph != NULL || pm.model().hasGraph();
+}
 
-private:
 
-	double r;
-	double previous;
-	unsigned long previousStep;
+inline naxos::NsIndex Initializer::degree (naxos::NsIndex i)
+{
+	return ( graph != NULL ) ? (*graph)[i].size() : pm.model().degree(i);
+}
 
-public:
 
-	GeometricScheduler(LsProblemManager& pm_, unsigned long stableSteps_, double r_) :
-			TemperatureScheduler(pm_, stableSteps_), r(r_), previous(100000.0), previousStep(0) {}
+inline naxos::NsIndex Initializer::neighbour (naxos::NsIndex i, naxos::NsIndex k)
+{
+	return ( graph != NULL ) ? (*graph)[i][k] : pm.model().neighbour(i, k);
+}
 
-	double operator[] (unsigned long step)
-	{
-		if ( step != previousStep )
-		{
-			previous = r * previous;
-			previousStep = step;
-		}
-		return previous;
-	}
-	
-	std::ostream& configuration (std::ostream&);
-};
 
+inline naxos::NsInt LsProblemManager::randomValue (naxos::NsIntVar& variable)
+{
+	using namespace naxos;
 
+	// A labeled variable is looked up in the compact model
+	NsIndex labeledIndex = variable.lsIndex();
+	if ( varArray != NULL && labeledIndex < compact.domains.size() && &(*varArray)[labeledIndex] == &variable )
+		return compact.domainValue( labeledIndex, random( compact.domains[labeledIndex].size ) );
 
+	NsInt 	domainIndex = random( variable.size() );
+	// A domain without holes is indexed directly
+	if ( variable.max() - variable.min() + 1 == static_cast<NsInt>(variable.size()) ) return variable.min() + domainIndex;
 
-///////////////// Inline for speed, must therefore reside in header file /////////////////
+	NsInt 	currentValue, index;
+	for ( currentValue = variable.min(), index = 0 ; index < domainIndex ; index++, currentValue = variable.next(currentValue) ) ;
 
-inline void LsProblemManager::initialize (void)
+	return currentValue;
+}
+
+
+inline void LsProblemManager::captureState (StateVector& state)
 {
-	using namespace naxos;
+	state.assign( compact.values.begin(), compact.values.end() );
+}
 
-	NsIntVarArray& 	variables = *varArray;
 
-	for ( NsIndex i = 0, size = variables.size() ; i < size ; i++ )
-	{
-		NsInt 	currentValue, index, domainIndex = random(variables[i].size());
+inline void LsProblemManager::restoreState (const StateVector& state)
+{
+	naxos::NsIntVarArray& 	variables = *varArray;
+
+	for ( naxos::NsIndex i = 0, size = variables.size() ; i < size ; i++ )
+		if ( compact.values[i] != state[i] ) applyAssignment( std::make_pair(&variables[i], state[i]) );
+}
 
-		for ( currentValue = variables[i].min(), index = 0 ; index < domainIndex ; index++, currentValue = variables[i].next(currentValue) ) ;
 
-		//std::cerr << "TRYING TO LSSET " << i << std::endl;
-		variables[i].lsSet(currentValue);
-	}
+inline unsigned long LsProblemManager::conflicts (void)
+{
+	unsigned long 	total = ( weightIncrement == 0 ) ? lsViolatedConstraints().size() : weightedConflicts;
+	if ( penaltyLambda != 0 ) total += penaltyLambda * currentPenalty;
 
-	tabuAssignments.clear();
+	return total;
 }
 
 
-inline void LsProblemManager::reset (void)
+inline unsigned long LsProblemManager::conflicts (naxos::NsIntVar& variable)
 {
-	for ( naxos::NsIndex i = 0, size = varArray->size() ; i < size ; i++ ) (*varArray)[i].lsUnset();
+	const ConfConstraints& violatedList = variable.lsViolatedConstraints();
+	if ( weightIncrement == 0 ) return violatedList.size();
+
+	if ( cachedVariable == &variable ) return cachedVariableConflicts;
+
+	unsigned long total = 0;
+	for ( ConfConstraints::const_iterator it = violatedList.begin() ; it != violatedList.end() ; it++ )
+		total += constraintWeight( *it );
+
+	return total;
+}
+
+
+inline void LsProblemManager::applyAssignment (Assignment assignment)
+{
+	// Only the constraints of the assigned variable may change state;
+	// Update the weighted conflicts by the difference in their weight
+	if ( weightIncrement != 0 ) weightedConflicts -= conflicts( *assignment.first );
+
+	naxos::NsIndex 	index = assignment.first->lsIndex();
+	int& 		value = compact.values[index];
+
+	if ( moveJournal.recording ) moveJournal.assignments.push_back( std::make_pair(assignment.first, value) );
+	if ( bestJournalValid )
+	{
+		bestJournal.push_back( std::make_pair(index, value) );
+		if ( bestJournal.size() > varArray->size() ) materializeBest();
+	}
+	if ( iteratedJournalValid )
+	{
+		iteratedJournal.push_back( std::make_pair(index, value) );
+		if ( iteratedJournal.size() > varArray->size() ) materializeIterated();
+	}
+
+	currentHash ^= hashAssignment( index, value ) ^ hashAssignment( index, assignment.second );
+	if ( penaltyLambda != 0 ) currentPenalty += penalty( index, static_cast<int>(assignment.second) ) - penalty( index, value );
+	value = static_cast<int>( assignment.second );
+
+	// Only the constraints of the assigned variable may change state; they are counted out and back in
+	if ( conflictsTracked ) countConflicts( assignment.first->lsViolatedConstraints(), false );
+	assignment.first->lsUnset();
+	assignment.first->lsSet( assignment.second );
+	if ( conflictsTracked ) countConflicts( assignment.first->lsViolatedConstraints(), true );
+
+	if ( weightIncrement != 0 )
+	{
+		cachedVariable = NULL;
+		cachedVariableConflicts = conflicts( *assignment.first );
+		cachedVariable = assignment.first;
+		weightedConflicts += cachedVariableConflicts;
+	}
 }
 
 
 inline bool LsProblemManager::tryAssignment (Assignment assignment)
 {
-	long currentConflicts = lsViolatedConstraints().size();
+	long currentConflicts = conflicts();
 	// globalMinConflicts is -1 at the beginning of each search process;
 	// Initialize or update its value here
 	if ( globalMinConflicts == -1 || currentConflicts < globalMinConflicts ) globalMinConflicts = currentConflicts;
 
 	// Temporary assign value to variable to compute the number of conflicting constraints
-	assignment.first->lsUnset();
-	assignment.first->lsSet( assignment.second );
-	long nextConflicts = lsViolatedConstraints().size();
+	applyAssignment( assignment );
+	long nextConflicts = conflicts();
 
 	// Allow assignment if it is not in the tabu list
 	// OR if it is but it satisfies the aspiration criterion
 	// (i.e. improves the incumbent candidate solution)
-	if ( !tabuAssignments.find( assignment ) || nextConflicts < globalMinConflicts ) return true;
+	if ( !isTabu( assignment ) || nextConflicts < globalMinConflicts ) return true;
 
 	//std::cerr << "\t\t\t\t\t\t\t\t\t\tTABU STATE IGNORED: " << assignment.first->lsIndex() << " - " << assignment.second << std::endl;
 	return false;
@@ -638,29 +2210,259 @@ inline bool LsProblemManager::tryAssignment (Assignment assignment)
 
 inline void LsProblemManager::commitAssignment (Assignment assignment)
 {
-	assignment.first->lsUnset();
-	assignment.first->lsSet( assignment.second );
+	applyAssignment( assignment );
 	// Add assignment in the tabu set
-	tabuAssignments.push( assignment );
+	pushTabu( assignment );
 }
 
 
 inline void LsProblemManager::revertToAssignment (Assignment assignment)
 {
 	// Remove last assignment, from the tabu set
-	tabuAssignments.pop_back();
+	popTabu();
 	// Revert to assignment
 	commitAssignment(assignment);
 }
 
 
-inline std::string LsProblemManager::hashState(naxos::NsIndex variable, naxos::NsInt value)
+inline void LsProblemManager::markMove (void)
+{
+	moveJournal.recording = true;
+	moveJournal.assignments.clear();
+	moveJournal.counts.clear();
+	moveJournal.hash = currentHash;
+	moveJournal.weightedConflicts = weightedConflicts;
+	moveJournal.penalty = currentPenalty;
+	moveJournal.cachedVariable = cachedVariable;
+	moveJournal.cachedVariableConflicts = cachedVariableConflicts;
+	moveJournal.conflictsTracked = conflictsTracked;
+	moveJournal.bestJournalSize = bestJournal.size();
+	moveJournal.iteratedJournalSize = iteratedJournal.size();
+}
+
+
+inline void LsProblemManager::undoMove (void)
+{
+	naxos::assert_Ns( moveJournal.recording, "LsProblemManager::undoMove: No move marked" );
+	moveJournal.recording = false;
+
+	// The compact values back to the mark, latest first
+	for ( std::vector<std::pair<VariablePtr, int> >::reverse_iterator it = moveJournal.assignments.rbegin() ; it != moveJournal.assignments.rend() ; it++ )
+		compact.values[ it->first->lsIndex() ] = it->second;
+	// Then naxos, once for every variable however many values it was given
+	for ( std::vector<std::pair<VariablePtr, int> >::iterator it = moveJournal.assignments.begin() ; it != moveJournal.assignments.end() ; it++ )
+	{
+		naxos::NsInt 	value = compact.values[ it->first->lsIndex() ];
+		if ( it->first->lsValue() == value ) continue;
+		it->first->lsUnset();
+		it->first->lsSet( value );
+	}
+
+	// A set built during the move is rebuilt on its next use
+	if ( !moveJournal.conflictsTracked )
+	{
+		conflictsTracked = false;
+	}
+	else
+	{
+		for ( std::vector<std::pair<naxos::NsIndex, bool> >::reverse_iterator it = moveJournal.counts.rbegin() ; it != moveJournal.counts.rend() ; it++ )
+		{
+			naxos::NsIndex 	i = it->first;
+			if ( it->second )
+			{
+				if ( --conflictCounts[i] != 0 ) continue;
+				VariablePtr 	last = conflictVariables.back();
+				conflictVariables[ conflictPositions[i] ] = last;
+				conflictPositions[ last->lsIndex() ] = conflictPositions[i];
+				conflictVariables.pop_back();
+			}
+			else if ( conflictCounts[i]++ == 0 )
+			{
+				conflictPositions[i] = conflictVariables.size();
+				conflictVariables.push_back( &(*varArray)[i] );
+			}
+		}
+	}
+
+	currentHash = moveJournal.hash;
+	weightedConflicts = moveJournal.weightedConflicts;
+	currentPenalty = moveJournal.penalty;
+	cachedVariable = moveJournal.cachedVariable;
+	cachedVariableConflicts = moveJournal.cachedVariableConflicts;
+	// Unless they have been materialized in between
+	if ( bestJournalValid && bestJournal.size() >= moveJournal.bestJournalSize ) bestJournal.resize( moveJournal.bestJournalSize );
+	if ( iteratedJournalValid && iteratedJournal.size() >= moveJournal.iteratedJournalSize ) iteratedJournal.resize( moveJournal.iteratedJournalSize );
+}
+
+
+inline void LsProblemManager::pushTabu (Assignment assignment)
+{
+	// A full list forgets its oldest assignment
+	if ( tabuAssignments.width() != 0 && tabuAssignments.size() == tabuAssignments.width() )
+		tabuCounts[ tabuAssignments.front().first->lsIndex() ]--;
+	tabuAssignments.push( assignment );
+	tabuCounts[ assignment.first->lsIndex() ]++;
+}
+
+
+inline void LsProblemManager::popTabu (void)
+{
+	if ( tabuAssignments.empty() ) return;
+	tabuCounts[ tabuAssignments.back().first->lsIndex() ]--;
+	tabuAssignments.pop_back();
+}
+
+
+inline void LsProblemManager::clearTabu (void)
 {
-	std::ostringstream out;
-	for ( naxos::NsIndex i = 0, size = varArray->size() ; i < size ; i++ ) out << (*varArray)[i].lsValue() << "|";
-	out << "|" << variable << "->" << value;
+	for ( ActiveWindow<Assignment>::iterator it = tabuAssignments.begin() ; it != tabuAssignments.end() ; it++ )
+		tabuCounts[ it->first->lsIndex() ] = 0;
+	tabuAssignments.clear();
+}
+
+
+inline bool LsProblemManager::isTabu (Assignment assignment)
+{
+	return tabuCounts[ assignment.first->lsIndex() ] != 0 && tabuAssignments.find( assignment );
+}
+
+
+inline bool LsProblemManager::tryRandomMove (VariablePtr variable)
+{
+	naxos::NsIndex 	i = variable->lsIndex();
+	naxos::NsInt 	currentValue = compact.values[i];
+	unsigned long 	size = compact.domains[i].size;
+	if ( size < 2 ) return false;
+
+	// Uniform over the other values; The current value, if drawn, stands for the last one
+	naxos::NsInt 	value = compact.domainValue( i, random( size - 1 ) );
+	if ( value == currentValue ) value = compact.domainValue( i, size - 1 );
+
+	Assignment 	move( variable, value );
+	markMove();
+	if ( !tryAssignment( move ) )
+	{
+		undoMove();
+		return false;
+	}
+	if ( tabuTenure != 0 ) pushTabu( move );
+
+	return true;
+}
+
+
+inline void LsProblemManager::rejectRandomMove (void)
+{
+	undoMove();
+	if ( tabuTenure != 0 ) popTabu();
+}
+
+
+inline void LsProblemManager::applySwap (VariablePtr first, VariablePtr second)
+{
+	naxos::NsInt firstValue = compact.values[ first->lsIndex() ];
+
+	applyAssignment( std::make_pair(first, static_cast<naxos::NsInt>( compact.values[ second->lsIndex() ] )) );
+	applyAssignment( std::make_pair(second, firstValue) );
+}
+
+
+inline bool LsProblemManager::trySwap (VariablePtr first, VariablePtr second, unsigned long& swapConflicts)
+{
+	if ( !first->contains( compact.values[ second->lsIndex() ] ) || !second->contains( compact.values[ first->lsIndex() ] ) ) return false;
+
+	long currentConflicts = conflicts();
+	if ( globalMinConflicts == -1 || currentConflicts < globalMinConflicts ) globalMinConflicts = currentConflicts;
+
+	// Only the constraints of the two variables change; swap, count and swap back
+	applySwap( first, second );
+	swapConflicts = conflicts();
+	applySwap( first, second );
+
+	// Allowed if not tabu, or if it improves the incumbent candidate solution (aspiration)
+	Swap swap = ( first < second ) ? std::make_pair(first, second) : std::make_pair(second, first);
+	return !tabuSwaps.find( swap ) || static_cast<long>(swapConflicts) < globalMinConflicts;
+}
+
+
+inline void LsProblemManager::commitSwap (VariablePtr first, VariablePtr second)
+{
+	applySwap( first, second );
+	tabuSwaps.push( ( first < second ) ? std::make_pair(first, second) : std::make_pair(second, first) );
+}
+
+
+inline void LsProblemManager::checkpointStep (unsigned long schedulerStep, unsigned long stableStep)
+{
+	if ( checkpointSteps == 0 ) return;
+
+	// A new best state; the journal starts over from it
+	if ( lsViolatedConstraints().size() < bestConflicts )
+	{
+		bestConflicts = lsViolatedConstraints().size();
+		bestJournal.clear();
+		bestJournalValid = true;
+	}
+
+	if ( ++stepsSinceCheckpoint < checkpointSteps ) return;
+	stepsSinceCheckpoint = 0;
+	if ( checkpointSeconds > 0.0 && checkpointTimer.elapsed() < checkpointSeconds ) return;
+
+	checkpointData.schedulerStep = schedulerStep;
+	checkpointData.stableStep = stableStep;
+	saveCheckpoint( checkpointPath );
+	checkpointTimer.start();
+}
+
+
+inline std::string LsProblemManager::hashSolution (void)
+{
+	const StateVector* 	solution = &compact.values;
+	// Symmetric solutions have the same representative
+	if ( canonicalizer != NULL )
+	{
+		canonicalizer->canonicalize( compact.values, canonicalBuffer );
+		solution = &canonicalBuffer;
+	}
 
-	return MD5_string( out.str() );
+	MD5 context;
+	if ( !solution->empty() )
+		context.update( reinterpret_cast<unsigned char*>( const_cast<int*>(&(*solution)[0]) ), solution->size() * sizeof(int) );
+	context.finalize();
+
+	char* 		digest = context.hex_digest();
+	std::string 	hash( digest );
+	delete[] digest;
+
+	return hash;
+}
+
+
+inline StateHash LsProblemManager::hashAssignment (naxos::NsIndex variable, naxos::NsInt value)
+{
+	// The SplitMix64 finalizer over the variable and value
+	StateHash x = ( static_cast<StateHash>(variable) << 32 ) ^ static_cast<StateHash>( static_cast<unsigned int>(value) );
+	x = ( x ^ (x >> 30) ) * 0xBF58476D1CE4E5B9UL;
+	x = ( x ^ (x >> 27) ) * 0x94D049BB133111EBUL;
+
+	return x ^ (x >> 31);
+}
+
+
+inline StateHash LsProblemManager::hashStep (naxos::NsIndex variable, naxos::NsInt value)
+{
+	// Rotated, so that the step isn't cancelled out by the same assignment in the state
+	StateHash step = hashAssignment( variable, value );
+
+	return currentHash ^ ( (step << 17) | (step >> 47) );
+}
+
+
+inline void LsProblemManager::rehashState (void)
+{
+	currentHash = 0;
+	for ( naxos::NsIndex i = 0, size = compact.values.size() ; i < size ; i++ )
+		currentHash ^= hashAssignment( i, compact.values[i] );
 }
 
 
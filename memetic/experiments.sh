@@ -0,0 +1,6 @@
+#! /bin/sh
+
+# Time to solution of hard 3-coloring instances; offspring from random colorings (independent restarts),
+# uniform crossover and greedy partition crossover, improved by hill climbing on 4 threads
+./memetic 300 3 4.5 10 4 2000 5 60 1325772160
+./memetic 500 3 4.6 20 4 5000 5 120 1325772160
@@ -0,0 +1,378 @@
+#include <naxos.h>
+#include <localS.h>
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+
+
+using namespace std;
+using namespace naxos;
+using namespace localS;
+
+
+// INSTANCES //
+
+// A random graph with a hidden coloring of `colors' colors, and `degree' average degree;
+// Near degree 4.7 for 3 colors the instances are the hardest
+struct Instance
+{
+	int 				nodes;
+	int 				colors;
+	vector< pair<int, int> > 	edges;
+
+	Instance (int nodes_, int colors_, double degree, unsigned long seed) : nodes(nodes_), colors(colors_)
+	{
+		MTRand_int32 	random( seed );
+		MTRand 		probability( seed + 1 );
+
+		vector<int> hidden( nodes );
+		for (int i = 0 ; i < nodes ; i++) hidden[i] = random( colors );
+
+		// Edges only between differently colored nodes, with the probability giving the average degree
+		double p = degree / ( nodes * (colors - 1.0) / colors );
+		for (int i = 0 ; i < nodes ; i++)
+			for (int j = 0 ; j < i ; j++)
+				if ( hidden[i] != hidden[j] && probability() < p ) edges.push_back( make_pair(i, j) );
+	}
+};
+
+
+// THREAD POOL //
+
+// Threads kept for the whole run; `run' hands out the tasks of a generation and waits for all of them
+class ThreadPool
+{
+
+private:
+
+	vector<thread> 					threads;
+	mutex 						lock;
+	condition_variable 				wake, done;
+	function<void (unsigned, unsigned)> 		task;
+	unsigned 					nextTask, tasks, finished;
+	unsigned long 					generation;
+	bool 						quit;
+
+	void loop (unsigned worker)
+	{
+		unsigned long seen = 0;
+		unique_lock<mutex> guard( lock );
+		while ( true )
+		{
+			wake.wait( guard, [&] { return quit || generation != seen; } );
+			if ( quit ) return;
+			seen = generation;
+
+			while ( nextTask < tasks )
+			{
+				unsigned t = nextTask++;
+				guard.unlock();
+				task( worker, t );
+				guard.lock();
+				if ( ++finished == tasks ) done.notify_all();
+			}
+		}
+	}
+
+public:
+
+	ThreadPool (unsigned size) : nextTask(0), tasks(0), finished(0), generation(0), quit(false)
+	{
+		for ( unsigned w = 0 ; w < size ; w++ ) threads.push_back( thread( &ThreadPool::loop, this, w ) );
+	}
+
+	~ThreadPool (void)
+	{
+		{
+			lock_guard<mutex> guard( lock );
+			quit = true;
+		}
+		wake.notify_all();
+		for ( size_t w = 0 ; w < threads.size() ; w++ ) threads[w].join();
+	}
+
+	// Calls `task_(worker, t)' for every `t' in [0, count), on the threads of the pool
+	void run (unsigned count, function<void (unsigned, unsigned)> task_)
+	{
+		unique_lock<mutex> guard( lock );
+		task = task_;
+		nextTask = 0;
+		tasks = count;
+		finished = 0;
+		generation++;
+		wake.notify_all();
+		done.wait( guard, [&] { return finished == tasks; } );
+	}
+};
+
+
+// WORKERS //
+
+// Thrown out of the search when its steps ran out, or another worker has found a solution
+struct Stopped {};
+
+struct BudgetVariable : public VariableHeuristic
+{
+	VariableHeuristic& 	heuristic;
+	const atomic<bool>& 	stop;
+	unsigned long 		budget;
+	unsigned long 		steps;
+
+	BudgetVariable (LsProblemManager& pm_, VariableHeuristic& heuristic_, const atomic<bool>& stop_) :
+			VariableHeuristic(pm_), heuristic(heuristic_), stop(stop_), budget(0), steps(0) {}
+
+	VariablePtr select (void)
+	{
+		if ( steps++ == budget || stop.load( memory_order_relaxed ) ) throw Stopped();
+		return heuristic.select();
+	}
+};
+
+
+// Every worker improves offspring with its own problem manager, on its own copy of the model,
+// so that the workers share nothing while searching
+class Worker
+{
+
+private:
+
+	LsProblemManager 			pm;
+	MaxConflictingVariable 			maxConflicting;
+	BudgetVariable 				selectVariable;
+	MinConflictingValue 			selectValue;
+	LsProblemManager::HillConfiguration 	conf;
+	NsIntVarArray 				Nodes;
+	unsigned long 				seed;
+
+public:
+
+	Worker (const Instance& instance, unsigned long seed_, const atomic<bool>& stop) : pm( 2, seed_ ), maxConflicting( pm ),
+			selectVariable( pm, maxConflicting, stop ), selectValue( pm ), conf( &selectVariable, &selectValue, 1000, 300, 0.05 ), seed( seed_ )
+	{
+		for (int i = 0 ; i < instance.nodes ; i++)
+			Nodes.push_back( NsIntVar(pm, 0, instance.colors - 1) );
+		for (size_t e = 0 ; e < instance.edges.size() ; e++)
+			pm.add( Nodes[instance.edges[e].first] != Nodes[instance.edges[e].second] );
+
+		pm.label(Nodes, &conf);
+	}
+
+	// Hill climbing from `values' for at most `budget' steps, with stream `stream' of the master seed;
+	// Leaves the state reached in `values' and returns its number of violated constraints
+	unsigned long improve (StateVector& values, unsigned long budget, unsigned long stream)
+	{
+		// A stream per offspring rather than per worker, so that the results don't depend on which worker ran which task
+		pm.randomStream( seed, stream );
+		selectVariable.budget = budget;
+		selectVariable.steps = 0;
+		pm.startFrom( values );
+		try {
+			pm.nextSolution();
+		} catch (Stopped&) {
+		}
+		pm.captureState( values );
+
+		return pm.lsViolatedConstraints().size();
+	}
+};
+
+
+// CROSSOVERS //
+
+// Greedy Partition Crossover (Galinier & Hao); The offspring takes the largest color class of each parent
+// in turn, removing its nodes from both; The nodes left over get random colors
+void partitionCrossover (const StateVector& first, const StateVector& second, int colors, StateVector& child, MTRand_int32& random)
+{
+	const StateVector* 	parents[] = {&first, &second};
+	size_t 			nodes = first.size();
+	vector<int> 		sizes( colors );
+
+	child.assign( nodes, -1 );
+	for ( int color = 0 ; color < colors ; color++ )
+	{
+		const StateVector& 	parent = *parents[ color % 2 ];
+		fill( sizes.begin(), sizes.end(), 0 );
+		for ( size_t i = 0 ; i < nodes ; i++ )
+			if ( child[i] == -1 ) sizes[ parent[i] ]++;
+
+		int 	largest = max_element( sizes.begin(), sizes.end() ) - sizes.begin();
+		for ( size_t i = 0 ; i < nodes ; i++ )
+			if ( child[i] == -1 && parent[i] == largest ) child[i] = color;
+	}
+	for ( size_t i = 0 ; i < nodes ; i++ )
+		if ( child[i] == -1 ) child[i] = random( colors );
+}
+
+
+// Every value from either parent at random
+void uniformCrossover (const StateVector& first, const StateVector& second, StateVector& child, MTRand_int32& random)
+{
+	child.resize( first.size() );
+	for ( size_t i = 0 ; i < first.size() ; i++ ) child[i] = random(2) ? first[i] : second[i];
+}
+
+
+// POPULATION //
+
+struct Individual
+{
+	StateVector 	values;
+	// With the colors renamed in order of appearance, so that equal partitions compare equal
+	StateVector 	canonical;
+	unsigned long 	conflicts;
+};
+
+
+// Differing nodes between the canonical colorings; zero for the same partition
+unsigned long distance (const Individual& a, const Individual& b)
+{
+	unsigned long d = 0;
+	for ( size_t i = 0 ; i < a.canonical.size() ; i++ ) d += ( a.canonical[i] != b.canonical[i] );
+	return d;
+}
+
+
+// Diversity-preserving replacement; An offspring closer than `minDistance' to an individual may only replace
+// that individual, if it is better; Otherwise it replaces the worst individual, if it is no worse
+bool replace (vector<Individual>& population, Individual& child, unsigned long minDistance)
+{
+	size_t 	closest = 0, worst = 0;
+	unsigned long closestDistance = NsUPLUS_INF;
+	for ( size_t p = 0 ; p < population.size() ; p++ )
+	{
+		unsigned long d = distance( population[p], child );
+		if ( d < closestDistance ) { closestDistance = d; closest = p; }
+		if ( population[p].conflicts > population[worst].conflicts ) worst = p;
+	}
+
+	size_t 	target = ( closestDistance < minDistance ) ? closest : worst;
+	if ( child.conflicts > population[target].conflicts || ( target == closest && closestDistance < minDistance
+			&& child.conflicts == population[target].conflicts ) )
+		return false;
+
+	swap( population[target], child );
+	return true;
+}
+
+
+enum Crossover {NONE, UNIFORM, PARTITION};
+const char* crossoverNames[] = {"none", "uniform", "GPX"};
+
+// Memetic search with `population' individuals and `threads' workers; returns the time to the first solution, or `limit';
+// Without crossover every offspring is a random coloring, i.e. independent restarts every `budget' steps
+double solve (const Instance& instance, unsigned population, unsigned threads, Crossover crossover, unsigned long budget,
+		unsigned long seed, double limit, unsigned long& generations, unsigned long& replacements)
+{
+	atomic<bool> 			stop( false );
+	vector< unique_ptr<Worker> > 	workers;
+	for ( unsigned w = 0 ; w < threads ; w++ ) workers.push_back( unique_ptr<Worker>( new Worker( instance, seed, stop ) ) );
+	ThreadPool 			pool( threads );
+	// Stream zero is the main thread's; the offspring of every generation take the next `population' streams
+	MTRand_int32 			random;
+	random.seedStream( seed, 0 );
+	unsigned long 			minDistance = instance.nodes / 10 + 1;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	double 	elapsed = 0.0;
+
+	// The initial population; random colorings, improved like every offspring
+	vector<Individual> 	individuals( population ), offspring( population );
+	for ( unsigned p = 0 ; p < population ; p++ )
+	{
+		individuals[p].values.resize( instance.nodes );
+		for (int i = 0 ; i < instance.nodes ; i++) individuals[p].values[i] = random( instance.colors );
+	}
+	pool.run( population, [&] (unsigned worker, unsigned p) {
+		// The canonicalizer keeps a buffer; one per task
+		ColorCanonicalizer 	canonicalizer;
+		individuals[p].conflicts = workers[worker]->improve( individuals[p].values, budget, 1 + p );
+		canonicalizer.canonicalize( individuals[p].values, individuals[p].canonical );
+		if ( individuals[p].conflicts == 0 ) stop = true;
+	} );
+	generations = 0;
+	replacements = 0;
+
+	while ( !stop && ( elapsed = chrono::duration<double>( chrono::steady_clock::now() - start ).count() ) < limit )
+	{
+		// Recombine pairs of distinct parents at random
+		for ( unsigned c = 0 ; c < population ; c++ )
+		{
+			unsigned 	a = random( population ), b = random( population - 1 );
+			if ( b >= a ) b++;
+			if ( crossover == PARTITION ) 		partitionCrossover( individuals[a].values, individuals[b].values, instance.colors, offspring[c].values, random );
+			else if ( crossover == UNIFORM ) 	uniformCrossover( individuals[a].values, individuals[b].values, offspring[c].values, random );
+			else
+			{
+				offspring[c].values.resize( instance.nodes );
+				for (int i = 0 ; i < instance.nodes ; i++) offspring[c].values[i] = random( instance.colors );
+			}
+		}
+
+		pool.run( population, [&] (unsigned worker, unsigned c) {
+			ColorCanonicalizer 	canonicalizer;
+			offspring[c].conflicts = workers[worker]->improve( offspring[c].values, budget, 1 + (generations + 1) * population + c );
+			canonicalizer.canonicalize( offspring[c].values, offspring[c].canonical );
+			if ( offspring[c].conflicts == 0 ) stop = true;
+		} );
+
+		for ( unsigned c = 0 ; c < population ; c++ )
+			replacements += replace( individuals, offspring[c], minDistance );
+		generations++;
+	}
+	elapsed = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+
+	bool solved = false;
+	for ( unsigned p = 0 ; p < population ; p++ ) solved = solved || individuals[p].conflicts == 0;
+	for ( unsigned c = 0 ; c < population && generations != 0 ; c++ ) solved = solved || offspring[c].conflicts == 0;
+
+	return solved ? elapsed : limit;
+}
+
+
+int main (int argc, char *argv[])
+{
+	if ( argc == 1 ) { cerr << "USAGE: nodes colors degree population threads budget runs timeLimit seed" << endl; exit(1); }
+
+	int nodes = (argc > 1) ? atoi(argv[1]) : 300;
+	int colors = (argc > 2) ? atoi(argv[2]) : 3;
+	double degree = (argc > 3) ? atof(argv[3]) : 4.5;
+	unsigned population = (argc > 4) ? atoi(argv[4]) : 10;
+	unsigned threads = (argc > 5) ? atoi(argv[5]) : 4;
+	unsigned long budget = (argc > 6) ? atol(argv[6]) : 2000;
+	int runs = (argc > 7) ? atoi(argv[7]) : 5;
+	double limit = (argc > 8) ? atof(argv[8]) : 60;
+	unsigned long seed = (argc > 9) ? atol(argv[9]) : time(NULL);
+
+	if ( population < 2 ) population = 2;
+	if ( threads < 1 ) threads = 1;
+
+	// Average time to the first solution over `runs' instances; unsolved runs count as `limit'
+	cout << "Crossover\tPopulation\tThreads\tAvgTime\tSolved\tAvgGenerations\tAvgReplacements" << endl;
+	Crossover crossovers[] = {NONE, UNIFORM, PARTITION};
+	for ( int x = 0 ; x < 3 ; x++ )
+	{
+		double 		totalTime = 0.0;
+		int 		solved = 0;
+		unsigned long 	totalGenerations = 0, totalReplacements = 0, generations, replacements;
+		for ( int r = 0 ; r < runs ; r++ )
+		{
+			Instance instance( nodes, colors, degree, seed + 1000 * r );
+			double elapsed = solve( instance, population, threads, crossovers[x], budget, seed + r, limit, generations, replacements );
+			totalTime += elapsed;
+			solved += ( elapsed < limit );
+			totalGenerations += generations;
+			totalReplacements += replacements;
+		}
+		cout << crossoverNames[ crossovers[x] ] << "\t" << population << "\t" << threads << "\t" << totalTime / runs << "\t"
+			<< solved << "/" << runs << "\t" << totalGenerations / runs << "\t" << totalReplacements / runs << endl;
+	}
+}
@@ -4,11 +4,6 @@
 // non-inline function definitions and static member definitions cannot
 // reside in header file because of the risk of multiple declarations
 
-// initialization of static private members
-unsigned long MTRand_int32::state[n] = {0x0UL};
-int MTRand_int32::p = 0;
-bool MTRand_int32::init = false;
-
 void MTRand_int32::gen_state() { // generate new state vector
 	for (int i = 0; i < (n - m); ++i)
 		state[i] = state[i + m] ^ twiddle(state[i], state[i + 1]);
@@ -47,3 +42,31 @@ void MTRand_int32::seed(const unsigned long* array, int size) { // init by array
 	state[0] = 0x80000000UL; // MSB is 1; assuring non-zero initial array
 	p = n; // force gen_state() to be called for next random number
 }
+
+void MTRand_int32::seedStream(unsigned long master, unsigned long stream) { // init stream of master seed
+	unsigned long key[8];
+	unsigned long x = master;
+	for (int k = 0; k < 2; ++k) {
+		// SplitMix64; the stream shifts the second draw
+		x += 0x9E3779B97F4A7C15UL + (k == 1 ? stream * 0xD1B54A32D192ED03UL : 0UL);
+		unsigned long z = x;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+		z ^= z >> 31;
+		key[2 * k] = z & 0xFFFFFFFFUL;
+		key[2 * k + 1] = (z >> 16 >> 16) & 0xFFFFFFFFUL;
+	}
+	key[4] = master & 0xFFFFFFFFUL; key[5] = (master >> 16 >> 16) & 0xFFFFFFFFUL;
+	key[6] = stream & 0xFFFFFFFFUL; key[7] = (stream >> 16 >> 16) & 0xFFFFFFFFUL;
+	seed(key, 8);
+}
+
+void MTRand_int32::getState(unsigned long* state_, int& p_) const { // save the generator
+	for (int i = 0; i < n; ++i) state_[i] = state[i];
+	p_ = p;
+}
+
+void MTRand_int32::setState(const unsigned long* state_, int p_) { // restore the generator
+	for (int i = 0; i < n; ++i) state[i] = state_[i] & 0xFFFFFFFFUL;
+	p = (p_ < 0 || p_ > n) ? n : p_;
+}
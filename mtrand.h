@@ -48,15 +48,21 @@
 
 class MTRand_int32 { // Mersenne Twister random number generator
 public:
-	// default constructor: uses default seed only if this is the first instance
-	MTRand_int32() { if (!init) seed(5489UL); init = true; }
+	// default constructor: uses the default seed
+	MTRand_int32() { seed(5489UL); }
 	// constructor with 32 bit int as seed
-	MTRand_int32(unsigned long s) { seed(s); init = true; }
+	MTRand_int32(unsigned long s) { seed(s); }
 	// constructor with array of size 32 bit ints as seed
-	MTRand_int32(const unsigned long* array, int size) { seed(array, size); init = true; }
+	MTRand_int32(const unsigned long* array, int size) { seed(array, size); }
 	// the two seed functions
 	void seed(unsigned long); // seed with 32 bit integer
 	void seed(const unsigned long*, int size); // seed with array
+	// seed with stream `stream' of `master': the 32 bit words of both, and of two SplitMix64
+	// values drawn from them, go through init by array; nearby masters or streams give unrelated
+	// states, and a stream is as cheap to create as an array seed, i.e. per worker or per restart.
+	// This is not a jump ahead: the streams start at pseudo-random points of the same period of
+	// 2^19937 - 1, so they are independent only with high probability, not disjoint by construction
+	void seedStream(unsigned long master, unsigned long stream);
 	// overload operator() to make this a generator (functor)
 	unsigned long operator()() { return rand_int32(); }
 	// generate number in [0, hi)
@@ -65,14 +71,19 @@ public:
 	unsigned long operator()(unsigned long lo, unsigned long hi) { return lo + (rand_int32() % (hi - lo)); }
 	// 2007-02-11: made the destructor virtual; thanks "double more" for pointing this out
 	virtual ~MTRand_int32() {} // destructor
+	// size of the state vector, for saving and restoring the generator
+	static const int stateSize = 624;
+	// copy the state vector and position out, or back in
+	void getState(unsigned long* state_, int& p_) const;
+	void setState(const unsigned long* state_, int p_);
 protected: // used by derived classes, otherwise not accessible; use the ()-operator
 	unsigned long rand_int32(); // generate 32 bit random integer
 	private:
 	static const int n = 624, m = 397; // compile time constants
-	// the variables below are static (no duplicates can exist)
-	static unsigned long state[n]; // state vector array
-	static int p; // position in state array
-	static bool init; // true if init function is called
+	// the variables below are per instance, so that generators used by
+	// different threads (e.g. one per problem manager) don't share a stream
+	unsigned long state[n]; // state vector array
+	int p; // position in state array
 	// private functions used to generate the pseudo random numbers
 	unsigned long twiddle(unsigned long, unsigned long); // used by gen_state()
 	void gen_state(); // generate new state
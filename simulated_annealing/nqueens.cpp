@@ -59,6 +59,11 @@ int main (int argc, char *argv[])
 		// LABELING //
 		pm.label(Var, &conf);
 
+		// CHECKPOINTS (optional) //
+		// Continue a killed run, and save its state every 100000 steps
+		//pm.restoreCheckpoint( "nqueens.checkpoint" );
+		//pm.checkpointEvery( "nqueens.checkpoint", 100000 );
+
 		// SOLVING //
 		//cout << N << "\t";
 		pm.configuration( cout );
@@ -0,0 +1,472 @@
+#include <walksat.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+using namespace localS;
+
+
+
+////////////////////////////////////// Input //////////////////////////////////////
+
+void SatProblemManager::addClause (const std::vector<Literal>& clause)
+{
+	naxos::assert_Ns( !clause.empty(), "SatProblemManager::addClause: Empty clause" );
+
+	// Repeated literals would spoil the true-literal counts; A clause with both `x' and `-x' is dropped
+	std::vector<Literal> 	sorted( clause );
+	std::sort( sorted.begin(), sorted.end() );
+	sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+	for ( size_t k = 1 ; k < sorted.size() ; k++ )
+		if ( variableOf( sorted[k] ) == variableOf( sorted[k - 1] ) ) return;
+
+	for ( size_t k = 0 ; k < sorted.size() ; k++ )
+	{
+		literals.push_back( sorted[k] );
+		if ( variableOf( sorted[k] ) >= variables ) variables = variableOf( sorted[k] ) + 1;
+	}
+	clauseOffsets.push_back( literals.size() );
+	indexed = false;
+}
+
+
+void SatProblemManager::parse (const char* begin, const char* end)
+{
+	const char* 		p = begin;
+	bool 			header = false;
+	unsigned long 		declaredVariables = 0;
+	std::vector<Literal> 	clause;
+
+	while ( p != end )
+	{
+		if ( *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' )
+		{
+			p++;
+			continue;
+		}
+		if ( *p == 'c' )
+		{
+			while ( p != end && *p != '\n' ) p++;
+			continue;
+		}
+		// The SATLIB instances end with a line of `%'
+		if ( *p == '%' ) break;
+		if ( *p == 'p' )
+		{
+			const char* 	line = p;
+			while ( p != end && *p != '\n' ) p++;
+			std::istringstream 	in( std::string( line, p ) );
+			std::string 		p_, format;
+			unsigned long 		declaredClauses;
+			naxos::assert_Ns( ( in >> p_ >> format >> declaredVariables >> declaredClauses ) && format == "cnf",
+				"SatProblemManager::load: Wrong `p cnf' line" );
+			literals.reserve( literals.size() + 3 * declaredClauses );
+			clauseOffsets.reserve( clauseOffsets.size() + declaredClauses );
+			header = true;
+			continue;
+		}
+		naxos::assert_Ns( header, "SatProblemManager::load: Clauses before the `p cnf' line" );
+
+		bool 		negated = ( *p == '-' );
+		if ( negated ) p++;
+		naxos::assert_Ns( p != end && '0' <= *p && *p <= '9', "SatProblemManager::load: Expected a literal" );
+		unsigned long 	number = 0;
+		while ( p != end && '0' <= *p && *p <= '9' ) number = 10 * number + ( *p++ - '0' );
+
+		if ( number == 0 )
+		{
+			addClause( clause );
+			clause.clear();
+		}
+		else
+		{
+			naxos::assert_Ns( number <= declaredVariables, "SatProblemManager::load: Literal beyond the declared variables" );
+			clause.push_back( negated ? negative(number - 1) : positive(number - 1) );
+		}
+	}
+	// The last clause may lack its terminating zero
+	if ( !clause.empty() ) addClause( clause );
+	if ( declaredVariables > variables ) variables = declaredVariables;
+}
+
+
+void SatProblemManager::load (const std::string& path)
+{
+	MappedFile 	file( path );
+	if ( file.size() >= 8 && std::memcmp( file.data(), "LSCNF001", 8 ) == 0 )
+		readBinary( file.data(), file.data() + file.size() );
+	else
+		parse( file.data(), file.data() + file.size() );
+}
+
+
+void SatProblemManager::save (const std::string& path)
+{
+	if ( !indexed ) index();
+
+	std::string 	out( "LSCNF001" );
+	out.reserve( 8 + 4 * ( 3 + clauseOffsets.size() + literals.size() + occurrenceOffsets.size() + occurrences.size() ) );
+	appendWord( out, variables );
+	appendWord( out, numClauses() );
+	appendWord( out, literals.size() );
+	for ( size_t k = 0 ; k < clauseOffsets.size() ; k++ ) appendWord( out, clauseOffsets[k] );
+	for ( size_t k = 0 ; k < literals.size() ; k++ ) appendWord( out, literals[k] );
+	for ( size_t k = 0 ; k < occurrenceOffsets.size() ; k++ ) appendWord( out, occurrenceOffsets[k] );
+	for ( size_t k = 0 ; k < occurrences.size() ; k++ ) appendWord( out, occurrences[k] );
+
+	std::ofstream 	file( path.c_str(), std::ios::binary );
+	file.write( out.data(), out.size() );
+	naxos::assert_Ns( file.good(), "SatProblemManager::save: Cannot write the formula file" );
+}
+
+
+void SatProblemManager::readBinary (const char* begin, const char* end)
+{
+	naxos::assert_Ns( numClauses() == 0, "SatProblemManager::readBinary: A saved formula is loaded into an empty manager" );
+	naxos::assert_Ns( end - begin >= 20, "SatProblemManager::readBinary: Truncated formula file" );
+
+	const char* 	p = begin + 8;
+	unsigned long 	v = readWord( p ), clauses = readWord( p + 4 ), literalCount = readWord( p + 8 );
+	p += 12;
+	naxos::assert_Ns( static_cast<unsigned long>( end - p ) == 4 * ( ( clauses + 1 ) + 2 * literalCount + ( 2 * v + 1 ) ),
+			"SatProblemManager::readBinary: Truncated formula file" );
+
+	// The arrays are copied as they were saved, indexing included
+	std::vector<unsigned int> 	savedClauseOffsets, savedLiterals, savedOccurrenceOffsets, savedOccurrences;
+	readWords( p, clauses + 1, savedClauseOffsets );
+	p += 4 * ( clauses + 1 );
+	readWords( p, literalCount, savedLiterals );
+	p += 4 * literalCount;
+	readWords( p, 2 * v + 1, savedOccurrenceOffsets );
+	p += 4 * ( 2 * v + 1 );
+	readWords( p, literalCount, savedOccurrences );
+
+	// Every index is checked before it is taken in, so that a damaged file can't send the search outside the arrays
+	naxos::assert_Ns( savedClauseOffsets[0] == 0 && savedClauseOffsets[clauses] == literalCount
+			&& savedOccurrenceOffsets[0] == 0 && savedOccurrenceOffsets[2 * v] == literalCount,
+			"SatProblemManager::readBinary: Offsets not spanning the literals" );
+	for ( unsigned long k = 0 ; k < clauses ; k++ )
+		naxos::assert_Ns( savedClauseOffsets[k] <= savedClauseOffsets[k + 1], "SatProblemManager::readBinary: Decreasing clause offsets" );
+	for ( unsigned long k = 0 ; k < 2 * v ; k++ )
+		naxos::assert_Ns( savedOccurrenceOffsets[k] <= savedOccurrenceOffsets[k + 1], "SatProblemManager::readBinary: Decreasing occurrence offsets" );
+	for ( unsigned long k = 0 ; k < literalCount ; k++ )
+		naxos::assert_Ns( savedLiterals[k] < 2 * v, "SatProblemManager::readBinary: Literal beyond the variables" );
+	// The occurrence lists must be those `index()' builds: every clause, in order, once in the list of each of its
+	// literals; Otherwise the counts the search keeps per clause stop matching its literals
+	std::vector<unsigned int> 	next( savedOccurrenceOffsets.begin(), savedOccurrenceOffsets.end() - 1 );
+	for ( unsigned int c = 0 ; c < clauses ; c++ )
+		for ( unsigned int k = savedClauseOffsets[c] ; k < savedClauseOffsets[c + 1] ; k++ )
+		{
+			unsigned int 	l = savedLiterals[k];
+			naxos::assert_Ns( next[l] < savedOccurrenceOffsets[l + 1] && savedOccurrences[ next[l]++ ] == c,
+					"SatProblemManager::readBinary: Occurrence lists not matching the clauses" );
+		}
+
+	variables = v;
+	clauseOffsets.swap( savedClauseOffsets );
+	literals.swap( savedLiterals );
+	occurrenceOffsets.swap( savedOccurrenceOffsets );
+	occurrences.swap( savedOccurrences );
+
+	assignment.resize( variables );
+	breakCount.resize( variables );
+	trueCount.resize( numClauses() );
+	trueVariables.resize( numClauses() );
+	unsatPosition.resize( numClauses() );
+	unsat.reserve( numClauses() );
+	indexed = true;
+}
+
+
+void SatProblemManager::index (void)
+{
+	occurrenceOffsets.assign( 2 * variables + 1, 0 );
+	for ( size_t k = 0 ; k < literals.size() ; k++ )
+		occurrenceOffsets[ literals[k] + 1 ]++;
+	for ( size_t l = 0 ; l < 2 * variables ; l++ )
+		occurrenceOffsets[l + 1] += occurrenceOffsets[l];
+
+	std::vector<unsigned int> 	next( occurrenceOffsets.begin(), occurrenceOffsets.end() - 1 );
+	occurrences.resize( literals.size() );
+	for ( unsigned int c = 0 ; c < numClauses() ; c++ )
+		for ( unsigned int k = clauseOffsets[c] ; k < clauseOffsets[c + 1] ; k++ )
+			occurrences[ next[ literals[k] ]++ ] = c;
+
+	assignment.resize( variables );
+	breakCount.resize( variables );
+	trueCount.resize( numClauses() );
+	trueVariables.resize( numClauses() );
+	unsatPosition.resize( numClauses() );
+	unsat.reserve( numClauses() );
+	indexed = true;
+}
+
+
+
+////////////////////////////////////// Search //////////////////////////////////////
+
+void SatProblemManager::initialize (void)
+{
+	for ( unsigned int v = 0 ; v < variables ; v++ ) assignment[v] = random(2);
+	std::fill( breakCount.begin(), breakCount.end(), 0 );
+	unsat.clear();
+
+	for ( unsigned int c = 0 ; c < numClauses() ; c++ )
+	{
+		trueCount[c] = 0;
+		trueVariables[c] = 0;
+		for ( unsigned int k = clauseOffsets[c] ; k < clauseOffsets[c + 1] ; k++ )
+		{
+			if ( isTrue( literals[k] ) )
+			{
+				trueCount[c]++;
+				trueVariables[c] ^= variableOf( literals[k] );
+			}
+		}
+		if ( trueCount[c] == 0 )
+		{
+			unsatPosition[c] = unsat.size();
+			unsat.push_back( c );
+		}
+		else if ( trueCount[c] == 1 )
+		{
+			breakCount[ trueVariables[c] ]++;
+		}
+	}
+}
+
+
+void SatProblemManager::flip (unsigned int variable)
+{
+	assignment[variable] ^= 1;
+	Literal 	made = assignment[variable] ? positive(variable) : negative(variable);
+	Literal 	broken = made ^ 1;
+
+	for ( unsigned int k = occurrenceOffsets[made] ; k < occurrenceOffsets[made + 1] ; k++ )
+	{
+		unsigned int 	c = occurrences[k];
+		if ( trueCount[c]++ == 0 )
+		{
+			// Leaves the unsatisfied set, the last clause taking its place
+			unsigned int 	last = unsat.back();
+			unsat[ unsatPosition[c] ] = last;
+			unsatPosition[last] = unsatPosition[c];
+			unsat.pop_back();
+			breakCount[variable]++;
+		}
+		else if ( trueCount[c] == 2 )
+		{
+			breakCount[ trueVariables[c] ]--;
+		}
+		trueVariables[c] ^= variable;
+	}
+
+	for ( unsigned int k = occurrenceOffsets[broken] ; k < occurrenceOffsets[broken + 1] ; k++ )
+	{
+		unsigned int 	c = occurrences[k];
+		trueVariables[c] ^= variable;
+		if ( --trueCount[c] == 0 )
+		{
+			unsatPosition[c] = unsat.size();
+			unsat.push_back( c );
+			breakCount[variable]--;
+		}
+		else if ( trueCount[c] == 1 )
+		{
+			breakCount[ trueVariables[c] ]++;
+		}
+	}
+}
+
+
+unsigned int SatProblemManager::pickWalkSat (unsigned int clause)
+{
+	WalkSatConfiguration* 	walkConf = static_cast<WalkSatConfiguration*>( conf );
+	unsigned int 		first = clauseOffsets[clause], size = clauseOffsets[clause + 1] - first;
+
+	// The least break count, ties broken at random
+	unsigned int 	best = 0, bestBreak = ~0U, ties = 0;
+	for ( unsigned int k = 0 ; k < size ; k++ )
+	{
+		unsigned int 	v = variableOf( literals[first + k] );
+		if ( breakCount[v] < bestBreak )
+		{
+			best = v;
+			bestBreak = breakCount[v];
+			ties = 1;
+		}
+		else if ( breakCount[v] == bestBreak && random( ++ties ) == 0 )
+		{
+			best = v;
+		}
+	}
+
+	if ( bestBreak == 0 )
+	{
+		walkConf->freebies++;
+		return best;
+	}
+	if ( probability() < walkConf->noise )
+		return variableOf( literals[ first + random(size) ] );
+
+	return best;
+}
+
+
+unsigned int SatProblemManager::pickProbSat (unsigned int clause)
+{
+	unsigned int 	first = clauseOffsets[clause], size = clauseOffsets[clause + 1] - first;
+
+	candidateWeights.resize( size );
+	double 	sum = 0.0;
+	for ( unsigned int k = 0 ; k < size ; k++ )
+	{
+		unsigned int 	b = breakCount[ variableOf( literals[first + k] ) ];
+		sum += candidateWeights[k] = breakWeights[ std::min<size_t>( b, breakWeights.size() - 1 ) ];
+	}
+
+	double 	r = probability() * sum;
+	for ( unsigned int k = 0 ; k < size - 1 ; k++ )
+	{
+		r -= candidateWeights[k];
+		if ( r < 0.0 ) return variableOf( literals[first + k] );
+	}
+
+	return variableOf( literals[first + size - 1] );
+}
+
+
+bool SatProblemManager::solve (Configuration* conf_)
+{
+	naxos::assert_Ns( conf_ != NULL, "SatProblemManager::solve: No configuration given" );
+	conf = conf_;
+	if ( !indexed ) index();
+
+	if ( conf->algorithm() == PROBSAT )
+	{
+		// A break count can't exceed the occurrences of a literal
+		ProbSatConfiguration* 	probConf = static_cast<ProbSatConfiguration*>( conf );
+		unsigned int 		maxOccurrences = 0;
+		for ( size_t l = 0 ; l < 2 * variables ; l++ )
+			maxOccurrences = std::max( maxOccurrences, occurrenceOffsets[l + 1] - occurrenceOffsets[l] );
+		breakWeights.resize( maxOccurrences + 1 );
+		for ( unsigned int b = 0 ; b <= maxOccurrences ; b++ )
+			breakWeights[b] = std::pow( probConf->eps + b, -probConf->cb );
+	}
+
+	Timer timer;
+	timer.start();
+	bool 	satisfied = false;
+	for ( conf->tries = 0 ; conf->tries < conf->maxTries && !satisfied ; conf->tries++ )
+	{
+		initialize();
+		for ( conf->flips = 0 ; conf->flips < conf->maxFlips && !unsat.empty() ; conf->flips++ )
+		{
+			unsigned int 	clause = unsat[ random( unsat.size() ) ];
+			flip( conf->algorithm() == WALKSAT ? pickWalkSat(clause) : pickProbSat(clause) );
+		}
+		conf->totalFlips += conf->flips;
+		satisfied = unsat.empty();
+	}
+	elapsedTime = timer.elapsed();
+
+	return satisfied;
+}
+
+
+
+////////////////////////////////////// Output //////////////////////////////////////
+
+std::ostream& SatProblemManager::solutionToString (std::ostream& out)
+{
+	// A DIMACS `v' line; "-[variable] " takes at most 13 characters
+	std::vector<char> 	buffer( 13 * variables + 1 );
+	char* 	p = &buffer[0];
+	for ( unsigned int v = 0 ; v < variables ; v++ )
+	{
+		p = TextSolutionWriter::format( p, assignment[v] ? static_cast<int>(v + 1) : -static_cast<int>(v + 1) );
+		*p++ = ' ';
+	}
+
+	out << "v ";
+	out.write( &buffer[0], p - &buffer[0] );
+	out << "0" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& SatProblemManager::configuration (std::ostream& out)
+{
+	out << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "---------------------Configuration--------------------" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "Random generator running with seed: `" << seed << "'" << std::endl;
+	out << "Formula: `" << variables << "' variables, `" << numClauses() << "' clauses" << std::endl;
+	// Print configuration parameters specific for the algorithm used
+	conf->configuration(out);
+	out << "------------------------------------------------------" << std::endl;
+
+	return out;
+}
+
+std::ostream& SatProblemManager::statistics (std::ostream& out)
+{
+	out << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "-----------------Solution  Statistics-----------------" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+	out << "Elapsed time: `" << elapsedTime << "' sec" << std::endl;
+	out << "Unsatisfied clauses: `" << unsat.size() << "'" << std::endl;
+	// Print statistics specific for the algorithm used
+	conf->statistics(out);
+	if ( elapsedTime > 0.0 )
+		out << "Flips per sec: `" << conf->totalFlips / elapsedTime << "'" << std::endl;
+	out << "------------------------------------------------------" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& SatProblemManager::Configuration::statistics (std::ostream& out)
+{
+	out << "Tries: `" << tries << "'" << std::endl;
+	out << "In last try used: `" << flips << "' flips" << std::endl;
+	out << "Total flips: `" << totalFlips << "'" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& SatProblemManager::WalkSatConfiguration::configuration (std::ostream& out)
+{
+	out << "Algorithm used: WalkSAT/SKC" << std::endl;
+	out << "Noise: `" << noise << "'" << std::endl;
+	out << "Max Flips per try: `" << maxFlips << "', Max Tries: `" << maxTries << "'" << std::endl;
+
+	return out;
+}
+
+std::ostream& SatProblemManager::WalkSatConfiguration::statistics (std::ostream& out)
+{
+	Configuration::statistics(out);
+	out << "Flips breaking no clause: `" << freebies << "'" << std::endl;
+
+	return out;
+}
+
+
+std::ostream& SatProblemManager::ProbSatConfiguration::configuration (std::ostream& out)
+{
+	out << "Algorithm used: ProbSAT (polynomial break)" << std::endl;
+	out << "cb: `" << cb << "', eps: `" << eps << "'" << std::endl;
+	out << "Max Flips per try: `" << maxFlips << "', Max Tries: `" << maxTries << "'" << std::endl;
+
+	return out;
+}
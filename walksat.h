@@ -0,0 +1,161 @@
+#ifndef LOCAL_S_WALKSAT_H
+#define LOCAL_S_WALKSAT_H
+
+#include <localS.h>
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+
+namespace localS
+{
+
+
+// A literal is `2 * variable' when positive and `2 * variable + 1' when negated; Variables are numbered from zero
+typedef unsigned int 					Literal;
+
+inline Literal positive (unsigned int variable) { return 2 * variable; }
+inline Literal negative (unsigned int variable) { return 2 * variable + 1; }
+inline unsigned int variableOf (Literal literal) { return literal >> 1; }
+
+
+
+////////////////////////////////////// SatProblemManager //////////////////////////////////////
+
+// Stochastic local search over CNF formulas, without naxos expressions; Every clause keeps its number of true
+// literals and, XOR-ed together, their variables, so that the only true variable of a clause is known at once,
+// and every variable keeps how many clauses it alone satisfies (its break count)
+class SatProblemManager
+{
+
+public:
+
+	enum Algorithm {WALKSAT, PROBSAT};
+
+	////////////////////////////////////// Configuration //////////////////////////////////////
+
+	struct Configuration
+	{
+		unsigned long 		maxFlips;
+		unsigned long 		maxTries;
+		unsigned long 		flips;
+		unsigned long 		totalFlips;
+		unsigned long 		tries;
+
+		Configuration (unsigned long maxFlips_, unsigned long maxTries_) :
+				maxFlips(maxFlips_), maxTries(maxTries_), flips(0), totalFlips(0), tries(0) {}
+		virtual ~Configuration(void) {}
+
+		virtual Algorithm algorithm (void) = 0;
+		virtual std::ostream& configuration (std::ostream&) = 0;
+		virtual std::ostream& statistics (std::ostream&);
+	};
+
+	////////////////////////////////////// WalkSatConfiguration //////////////////////////////////////
+
+	// WalkSAT/SKC: A variable of a random unsatisfied clause that breaks no clause is flipped, otherwise
+	// a random one with probability `noise', otherwise one with the least break count
+	struct WalkSatConfiguration : public Configuration
+	{
+		double 			noise;
+		unsigned long 		freebies;
+
+		WalkSatConfiguration (double noise_ = 0.567, unsigned long maxFlips_ = naxos::NsUPLUS_INF, unsigned long maxTries_ = 1) :
+				Configuration(maxFlips_, maxTries_), noise(noise_), freebies(0)
+		{
+			naxos::assert_Ns( 0.0 <= noise && noise <= 1.0, "WalkSatConfiguration::WalkSatConfiguration: The noise must be a probability" );
+		}
+
+		Algorithm algorithm (void) { return WALKSAT; }
+		std::ostream& configuration (std::ostream&);
+		std::ostream& statistics (std::ostream&);
+	};
+
+	////////////////////////////////////// ProbSatConfiguration //////////////////////////////////////
+
+	// ProbSAT (polynomial break): A variable of a random unsatisfied clause is flipped with probability
+	// proportional to `(eps + break) ^ -cb'
+	struct ProbSatConfiguration : public Configuration
+	{
+		double 			cb;
+		double 			eps;
+
+		ProbSatConfiguration (double cb_ = 2.38, double eps_ = 1.0, unsigned long maxFlips_ = naxos::NsUPLUS_INF, unsigned long maxTries_ = 1) :
+				Configuration(maxFlips_, maxTries_), cb(cb_), eps(eps_)
+		{
+			naxos::assert_Ns( eps > 0.0, "ProbSatConfiguration::ProbSatConfiguration: `eps' must be positive" );
+		}
+
+		Algorithm algorithm (void) { return PROBSAT; }
+		std::ostream& configuration (std::ostream&);
+	};
+
+protected:
+
+	unsigned int 			variables;
+	// The literals of clause `c' are `literals[clauseOffsets[c] .. clauseOffsets[c + 1])'
+	std::vector<unsigned int> 	clauseOffsets;
+	std::vector<Literal> 		literals;
+	// The clauses containing literal `l' are `occurrences[occurrenceOffsets[l] .. occurrenceOffsets[l + 1])'
+	std::vector<unsigned int> 	occurrenceOffsets;
+	std::vector<unsigned int> 	occurrences;
+	bool 				indexed;
+
+	std::vector<char> 		assignment;
+	std::vector<unsigned int> 	trueCount;
+	std::vector<unsigned int> 	trueVariables;
+	std::vector<unsigned int> 	breakCount;
+	// Sparse set of the unsatisfied clauses; `unsatPosition[c]' is the position of `c' in `unsat'
+	std::vector<unsigned int> 	unsat;
+	std::vector<unsigned int> 	unsatPosition;
+	// ProbSAT's weight of every break count, and the weights of the candidates of a step
+	std::vector<double> 		breakWeights;
+	std::vector<double> 		candidateWeights;
+
+	Configuration* 			conf;
+	unsigned long 			seed;
+	double 				elapsedTime;
+	MTRand_int32 			random;
+	MTRand 				probability;
+
+	void index (void);
+	void parse (const char* begin, const char* end);
+	void readBinary (const char* begin, const char* end);
+	void initialize (void);
+	void flip (unsigned int variable);
+	unsigned int pickWalkSat (unsigned int clause);
+	unsigned int pickProbSat (unsigned int clause);
+
+	bool isTrue (Literal literal) const { return static_cast<Literal>( assignment[ variableOf(literal) ] ) != ( literal & 1 ); }
+
+public:
+
+	SatProblemManager (unsigned long seed_ = 1) : variables(0), indexed(false), conf(NULL), seed(seed_), elapsedTime(0.0),
+			random(seed), probability(seed + 1) { clauseOffsets.push_back(0); }
+	virtual ~SatProblemManager (void) {}
+
+	// Reads a DIMACS CNF file, or one written by `save'; It is memory-mapped where the platform allows it
+	void load (const std::string& path);
+	// Writes the formula with its occurrence lists ("LSCNF001", then 32 bit little endian words),
+	// so that loading it back skips both the parsing and the indexing
+	void save (const std::string& path);
+	void addClause (const std::vector<Literal>& clause);
+
+	unsigned int numVariables (void) const { return variables; }
+	unsigned int numClauses (void) const { return clauseOffsets.size() - 1; }
+	unsigned int numUnsatisfied (void) const { return unsat.size(); }
+	bool value (unsigned int variable) const { return assignment[variable] != 0; }
+
+	// Returns true when a satisfying assignment was found within the configured tries and flips
+	bool solve (Configuration* conf_);
+
+	std::ostream& solutionToString (std::ostream& out);
+	std::ostream& configuration (std::ostream& out);
+	std::ostream& statistics (std::ostream& out);
+};
+
+
+} // end namespace
+
+#endif // LOCAL_S_WALKSAT_H